@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+#include <glap/glap.h>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    using CompileCommand = glap::model::Command<glap::Names<"compile", 'c'>,
+        glap::model::Flag<glap::Names<"verbose", 'v'>>,
+        glap::model::Flag<glap::Names<"debug", 'g'>>,
+        glap::model::Parameter<glap::Names<"output", 'o'>>,
+        glap::model::Parameters<glap::Names<"define", 'D'>>,
+        glap::model::Inputs<>
+    >;
+    using RunCommand = glap::model::Command<glap::Names<"run", 'r'>,
+        glap::model::Flag<glap::Names<"quiet", 'q'>>,
+        glap::model::Parameter<glap::Names<"timeout", 't'>>,
+        glap::model::Inputs<>
+    >;
+    using AuditProgram = glap::model::Program<"audit", glap::model::DefaultCommand::FirstDefined, CompileCommand, RunCommand>;
+
+    /// Recorded invocations, as read from an audit log: one command line per entry
+    struct AuditLog {
+        std::vector<std::vector<std::string>> lines;
+        std::vector<std::vector<std::string_view>> views;
+
+        explicit AuditLog(size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                auto id = std::to_string(i);
+                if (i % 3 == 0)
+                    lines.push_back({"audit", "run", "-q", "--timeout=" + id, "job" + id});
+                else
+                    lines.push_back({"audit", "compile", "-vg", "-o", "out" + id + ".o", "--define=ID=" + id, "-D", "NDEBUG", "src/file" + id + ".cpp"});
+            }
+            for (const auto& line : lines)
+                views.emplace_back(line.begin(), line.end());
+        }
+    };
+
+    void parse_serial(benchmark::State& state) {
+        auto log = AuditLog(static_cast<size_t>(state.range(0)));
+        for (auto _ : state) {
+            for (const auto& line : log.views) {
+                auto result = glap::parser<AuditProgram>(line);
+                benchmark::DoNotOptimize(result);
+            }
+        }
+        state.counters["lines/s"] = benchmark::Counter(static_cast<double>(state.iterations() * log.views.size()), benchmark::Counter::kIsRate);
+    }
+    void parse_batch(benchmark::State& state) {
+        auto log = AuditLog(static_cast<size_t>(state.range(0)));
+        auto threads = static_cast<unsigned>(state.range(1));
+        auto results = std::vector<glap::PosExpected<AuditProgram>>(log.views.size());
+        for (auto _ : state) {
+            if (!glap::parse_batch<AuditProgram>(log.views, std::span(results), glap::BatchOptions{.threads = threads}))
+                state.SkipWithError("results do not fit");
+            benchmark::DoNotOptimize(results.data());
+        }
+        auto lines = static_cast<double>(state.iterations() * log.views.size());
+        state.counters["lines/s"] = benchmark::Counter(lines, benchmark::Counter::kIsRate);
+        state.counters["lines/s/core"] = benchmark::Counter(lines / threads, benchmark::Counter::kIsRate);
+    }
+}
+
+BENCHMARK(parse_serial)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(parse_batch)->ArgsProduct({{100000}, {1, 2, 4, 8}})->Unit(benchmark::kMillisecond)->UseRealTime();
\ No newline at end of file
@@ -0,0 +1,119 @@
+-- Compile-time benchmark of generated glap models (glap-compile-bench target)
+--
+-- For each size COMMANDSxARGUMENTS, a program of COMMANDS commands of ARGUMENTS arguments each (the last one being
+-- the inputs) is generated with its help model, then compiled with the flags of the target. The parser and the help
+-- texts are instantiated. The wall time, the peak memory of the compiler and the size of the object are reported, and
+-- saved in compile-bench.csv. Clang (and clang-cl) also writes a -ftime-trace JSON file next to each object; the
+-- -ftime-report of GCC goes to the .log file of the object. MSVC gets no extra flag. The peak memory needs
+-- /usr/bin/time (Linux and macOS), and is left empty without it.
+import("core.tool.compiler")
+
+local shortnames = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
+local kinds = {"Flag", "Parameter", "Parameters", "Flag"}
+
+-- source of a program of `nb_commands` commands of `nb_arguments` arguments
+function _generate(nb_commands, nb_arguments)
+    local lines = {
+        format("// Generated by the glap-compile-bench target: %d commands x %d arguments", nb_commands, nb_arguments),
+        "#include <glap/glap.h>",
+        "#include <glap/help.h>",
+        "#include <array>",
+        "#include <span>",
+        "#include <string_view>",
+        ""
+    }
+    local commands = {}
+    local commands_help = {}
+    local texts = {"glap::help_text<ProgramHelp, Program>"}
+    for c = 0, nb_commands - 1 do
+        local arguments = {}
+        local arguments_help = {}
+        for a = 0, nb_arguments - 2 do
+            local shortname = a < #shortnames and format(", '%s'", shortnames:sub(a + 1, a + 1)) or ""
+            table.insert(arguments, format('    glap::model::%s<glap::Names<"argument%d"%s>>', kinds[a % #kinds + 1], a, shortname))
+            table.insert(arguments_help, format('    glap::help::model::Argument<"argument%d", glap::help::model::Description<"argument %d">>', a, a))
+        end
+        table.insert(arguments, "    glap::model::Inputs<>")
+        table.insert(arguments_help, '    glap::help::model::Argument<"INPUTS", glap::help::model::Description<"inputs">>')
+        table.insert(lines, format('using Command%d = glap::model::Command<glap::Names<"command%d">,\n%s\n>;', c, c, table.concat(arguments, ",\n")))
+        table.insert(lines, format('using Command%dHelp = glap::help::model::Command<"command%d", glap::help::model::Description<"command %d">,\n%s\n>;', c, c, c, table.concat(arguments_help, ",\n")))
+        table.insert(commands, format("Command%d", c))
+        table.insert(commands_help, format("Command%dHelp", c))
+        table.insert(texts, format("glap::help_text<Command%dHelp, Command%d>", c, c))
+    end
+    table.insert(lines, format('using Program = glap::model::Program<"program", glap::model::DefaultCommand::FirstDefined, %s>;', table.concat(commands, ", ")))
+    table.insert(lines, format('using ProgramHelp = glap::help::model::Program<"program", glap::help::model::Description<"generated program">, %s>;', table.concat(commands_help, ", ")))
+    table.insert(lines, "")
+    table.insert(lines, "auto parse(std::span<const std::string_view> args) {")
+    table.insert(lines, "    return glap::parser<Program>(args);")
+    table.insert(lines, "}")
+    table.insert(lines, "auto help(size_t index) -> std::string_view {")
+    table.insert(lines, "    static constexpr auto texts = std::array{")
+    table.insert(lines, "        " .. table.concat(texts, ",\n        "))
+    table.insert(lines, "    };")
+    table.insert(lines, "    return texts[index];")
+    table.insert(lines, "}")
+    return table.concat(lines, "\n") .. "\n"
+end
+
+-- timing reports of the compiler, by xmake tool name; none for MSVC and unknown compilers
+local trace_flags_by_tool = {
+    clang = {"-ftime-trace"},
+    clangxx = {"-ftime-trace"},
+    clang_cl = {"/clang:-ftime-trace"},
+    gcc = {"-ftime-report"},
+    gxx = {"-ftime-report"}
+}
+
+-- runs `program` and returns the wall time in seconds, and the peak resident memory in KiB when the host can tell it
+function _measure(program, argv, errfile)
+    local rssfile = os.tmpfile()
+    local run_program, run_argv = program, argv
+    if is_host("linux") and os.isfile("/usr/bin/time") then
+        run_program = "/usr/bin/time"
+        run_argv = table.join({"-f", "%M", "-o", rssfile, program}, argv)
+    elseif is_host("macosx") and os.isfile("/usr/bin/time") then
+        run_program = "/usr/bin/time"
+        run_argv = table.join({"-l", program}, argv)
+    end
+    local start = os.mclock()
+    os.execv(run_program, run_argv, {stderr = errfile})
+    local seconds = (os.mclock() - start) / 1000
+    local rss
+    if os.isfile(rssfile) then
+        rss = tonumber(io.readfile(rssfile):match("(%d+)%s*$"))
+        os.rm(rssfile)
+    elseif is_host("macosx") then
+        local bytes = io.readfile(errfile):match("(%d+)%s+maximum resident set size")
+        rss = bytes and math.floor(tonumber(bytes) / 1024)
+    end
+    return seconds, rss
+end
+
+function main(target, sizes)
+    local outputdir = path.join(target:autogendir(), "compile-bench")
+    local _, toolname = target:tool("cxx")
+    local trace_flags = trace_flags_by_tool[toolname] or {}
+    local rows = {"commands,arguments,seconds,peak_rss_kib,object_bytes"}
+    cprint("${bright}%-10s %10s %12s %14s", "model", "time (s)", "peak (MiB)", "object (KiB)")
+    for nb_commands, nb_arguments in sizes:gmatch("(%d+)x(%d+)") do
+        nb_commands, nb_arguments = tonumber(nb_commands), tonumber(nb_arguments)
+        assert(nb_commands > 0 and nb_arguments > 0, "compile_bench_sizes: a model has at least one command and one argument")
+        local name = format("%dx%d", nb_commands, nb_arguments)
+        local sourcefile = path.join(outputdir, name .. ".cpp")
+        local objectfile = path.join(outputdir, name .. ".o")
+        local errfile = path.join(outputdir, name .. ".log")
+        io.writefile(sourcefile, _generate(nb_commands, nb_arguments))
+        os.tryrm(objectfile)
+
+        local program, argv = compiler.compargv(sourcefile, objectfile, {target = target})
+        local seconds, rss = _measure(program, table.join(trace_flags, argv), errfile)
+        local object_size = os.isfile(objectfile) and os.filesize(objectfile) or 0
+
+        cprint("%-10s %10.2f %12s %14d", name, seconds, rss and format("%.1f", rss / 1024) or "-", math.floor(object_size / 1024))
+        table.insert(rows, format("%d,%d,%.3f,%s,%d", nb_commands, nb_arguments, seconds, rss or "", object_size))
+    end
+    local report = path.join(outputdir, "compile-bench.csv")
+    io.writefile(report, table.concat(rows, "\n") .. "\n")
+    cprint("report written to ${underline}%s", report)
+end
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include <benchmark/benchmark.h>
+#include <glap/glap.h>
+#include <glap/help.h>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+    template <size_t I>
+    constexpr auto indexed_name(char letter) {
+        char name[] = "x000";
+        name[0] = letter;
+        name[1] += I / 100;
+        name[2] += (I / 10) % 10;
+        name[3] += I % 10;
+        return glap::StringLiteral(name);
+    }
+    constexpr std::string_view ascii_shortnames = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    template <size_t I>
+    constexpr auto ascii_shortname() {
+        if constexpr (I < ascii_shortnames.size())
+            return static_cast<char32_t>(ascii_shortnames[I]);
+        else
+            return glap::discard;
+    }
+    template <size_t I>
+    constexpr char32_t greek_shortname() {
+        return U'α' + I;
+    }
+
+    template <class Seq>
+    struct MakeFlags;
+    template <size_t ...I>
+    struct MakeFlags<std::index_sequence<I...>> {
+        using type = glap::model::Command<glap::Names<"flags", 'f'>,
+            glap::model::Flag<glap::Names<indexed_name<I>('f'), ascii_shortname<I>()>>...
+        >;
+    };
+    template <class Seq>
+    struct MakeParams;
+    template <size_t ...I>
+    struct MakeParams<std::index_sequence<I...>> {
+        using type = glap::model::Command<glap::Names<"params", 'p'>,
+            glap::model::Parameters<glap::Names<indexed_name<I>('p'), ascii_shortname<I>()>>...,
+            glap::model::Inputs<>
+        >;
+    };
+    template <class Seq>
+    struct MakeUnicode;
+    template <size_t ...I>
+    struct MakeUnicode<std::index_sequence<I...>> {
+        using type = glap::model::Command<glap::Names<"unicode", 'u'>,
+            glap::model::Flag<glap::Names<indexed_name<I>('u'), greek_shortname<I>()>>...
+        >;
+    };
+    constexpr size_t nb_flags = 64;
+    constexpr size_t nb_params = 16;
+    constexpr size_t nb_unicode = 16;
+    using FlagsCommand = MakeFlags<std::make_index_sequence<nb_flags>>::type;
+    using ParamsCommand = MakeParams<std::make_index_sequence<nb_params>>::type;
+    using UnicodeCommand = MakeUnicode<std::make_index_sequence<nb_unicode>>::type;
+    using BenchProgram = glap::model::Program<"bench", glap::model::DefaultCommand::FirstDefined, FlagsCommand, ParamsCommand, UnicodeCommand>;
+
+    using FlagsHelp = glap::help::model::Command<"flags", glap::help::model::Description<"many flags">,
+        glap::help::model::Argument<"f000", glap::help::model::Description<"first flag">>,
+        glap::help::model::Argument<"f001", glap::help::model::Description<"second flag">>
+    >;
+    using ParamsHelp = glap::help::model::Command<"params", glap::help::model::FullDescription<"many parameters", "parameters and inputs with thousands of values">,
+        glap::help::model::Argument<"p000", glap::help::model::Description<"first parameter">>,
+        glap::help::model::Argument<"INPUTS", glap::help::model::Description<"input files">>
+    >;
+    using ProgramHelp = glap::help::model::Program<"bench", glap::help::model::Description<"glap benchmark program">, FlagsHelp, ParamsHelp>;
+
+    /// Owns the strings of a synthetic command line and exposes them as views
+    struct Argv {
+        std::vector<std::string> storage;
+        std::vector<std::string_view> args;
+
+        Argv(std::initializer_list<std::string> init) : storage(init) {}
+        void push(std::string arg) {
+            storage.push_back(std::move(arg));
+        }
+        const std::vector<std::string_view>& views() {
+            args.assign(storage.begin(), storage.end());
+            return args;
+        }
+    };
+
+    std::string indexed(char letter, size_t i) {
+        return letter + std::to_string(1000 + i).substr(1);
+    }
+
+    void run_parser(benchmark::State& state, Argv& argv, glap::ParseOptions options = {}) {
+        const auto& args = argv.views();
+        for (auto _ : state) {
+            auto result = glap::parser<BenchProgram>(args, options);
+            if (!result)
+                state.SkipWithError(result.error().to_string().c_str());
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * args.size());
+    }
+
+    void parse_long_flags(benchmark::State& state) {
+        auto argv = Argv{"bench", "flags"};
+        for (int64_t i = 0; i < state.range(0); ++i)
+            argv.push("--" + indexed('f', i % nb_flags));
+        run_parser(state, argv);
+    }
+    void parse_long_values(benchmark::State& state) {
+        auto argv = Argv{"bench", "params"};
+        for (int64_t i = 0; i < state.range(0); ++i)
+            argv.push("--" + indexed('p', i % nb_params) + "=value" + std::to_string(i));
+        run_parser(state, argv);
+    }
+    void parse_short_clusters(benchmark::State& state) {
+        auto argv = Argv{"bench", "flags"};
+        for (int64_t i = 0; i < state.range(0); ++i)
+            argv.push("-" + std::string(ascii_shortnames));
+        run_parser(state, argv);
+    }
+    void parse_short_values(benchmark::State& state) {
+        auto argv = Argv{"bench", "params"};
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            argv.push("-" + std::string(1, ascii_shortnames[i % nb_params]));
+            argv.push("value" + std::to_string(i));
+        }
+        run_parser(state, argv);
+    }
+    void parse_inputs(benchmark::State& state) {
+        auto argv = Argv{"bench", "params"};
+        for (int64_t i = 0; i < state.range(0); ++i)
+            argv.push("/data/input/file" + std::to_string(i) + ".json");
+        run_parser(state, argv);
+    }
+    void parse_inputs_presize(benchmark::State& state) {
+        auto argv = Argv{"bench", "params"};
+        for (int64_t i = 0; i < state.range(0); ++i)
+            argv.push("/data/input/file" + std::to_string(i) + ".json");
+        run_parser(state, argv, glap::ParseOptions{.presize = true});
+    }
+    void parse_unicode_clusters(benchmark::State& state) {
+        auto argv = Argv{"bench", "unicode"};
+        for (int64_t i = 0; i < state.range(0); ++i)
+            argv.push("-αβγδεζηθικλμνξοπ");
+        run_parser(state, argv);
+    }
+
+    void help_program(benchmark::State& state) {
+        for (auto _ : state)
+            benchmark::DoNotOptimize(glap::get_help<ProgramHelp, BenchProgram>());
+    }
+    void help_command(benchmark::State& state) {
+        for (auto _ : state)
+            benchmark::DoNotOptimize(glap::get_help<ParamsHelp, ParamsCommand>());
+    }
+}
+
+BENCHMARK(parse_long_flags)->Arg(64)->Arg(1024);
+BENCHMARK(parse_long_values)->Arg(64)->Arg(1024);
+BENCHMARK(parse_short_clusters)->Arg(16)->Arg(256);
+BENCHMARK(parse_short_values)->Arg(64)->Arg(1024);
+BENCHMARK(parse_inputs)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(parse_inputs_presize)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(parse_unicode_clusters)->Arg(16)->Arg(256);
+BENCHMARK(help_program);
+BENCHMARK(help_command);
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+#include <glap/core/utf8.h>
+#include <string>
+#include <string_view>
+
+namespace {
+    std::string make_text(size_t size, std::string_view pattern) {
+        std::string text;
+        text.reserve(size + pattern.size());
+        while (text.size() + pattern.size() <= size)
+            text += pattern;
+        text.append(size - text.size(), 'a');
+        return text;
+    }
+    constexpr std::string_view ascii_pattern = "--input=/usr/share/data/file.json ";
+    constexpr std::string_view mixed_pattern = "héllo wörld 中文 \U0001F525 ";
+
+    void utf8_length_ascii(benchmark::State& state) {
+        auto text = make_text(state.range(0), ascii_pattern);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(glap::utils::uni::utf8_length(text));
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    void utf8_length_mixed(benchmark::State& state) {
+        auto text = make_text(state.range(0), mixed_pattern);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(glap::utils::uni::utf8_length(text));
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    void utf8_validate_mixed(benchmark::State& state) {
+        auto text = make_text(state.range(0), mixed_pattern);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(glap::utils::uni::utf8_validate(text));
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    void utf8_count_mixed(benchmark::State& state) {
+        auto text = make_text(state.range(0), mixed_pattern);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(glap::utils::uni::utf8_count(text));
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(utf8_length_ascii)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK(utf8_length_mixed)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK(utf8_validate_mixed)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK(utf8_count_mixed)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 24);
@@ -0,0 +1,89 @@
+#pragma once
+
+#ifndef GLAP_MODULE
+#include "core/base.h"
+#include "core/error.h"
+#include "core/parallel.h"
+#include "parser.h"
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+
+GLAP_EXPORT namespace glap::impl
+{
+    /// Command line whose arguments can be viewed after being read: lvalues, or views already.
+    /// Prvalue strings would be destroyed while the parse result still views them.
+    template <class Argv>
+    concept ViewableArguments = std::is_lvalue_reference_v<std::ranges::range_reference_t<Argv>>
+        || std::same_as<std::remove_cv_t<std::ranges::range_reference_t<Argv>>, std::string_view>;
+}
+
+GLAP_EXPORT namespace glap
+{
+    /// Options of `parse_batch`
+    struct BatchOptions {
+        /// Number of threads, the calling one included. 0 uses every hardware thread.
+        unsigned threads = 0;
+        /// Number of command lines a thread parses between two looks at the shared counters.
+        std::size_t chunk = 64;
+        /// Options of each parse. `threads` and `pool` are ignored, and `resource` must be thread safe.
+        ParseOptions parse = {};
+    };
+
+    /// Parses each command line of `argvs` into the same index of `output`, on several threads.
+    /// `argvs` is a random access range of ranges of `std::string_view` (or lvalues convertible to it). `output` is
+    /// allocated by the caller: when it is smaller than `argvs`, nothing is parsed and false is returned.
+    /// Each thread owns a block of command lines and steals chunks of the others when its block is done.
+    template <class Model, std::ranges::random_access_range Argvs>
+        requires std::ranges::sized_range<Argvs>
+            && impl::Range<std::ranges::range_reference_t<Argvs>, std::string_view>
+            && impl::ViewableArguments<std::ranges::range_reference_t<const Argvs>>
+    [[nodiscard]] bool parse_batch(const Argvs& argvs, std::span<PosExpected<Model>> output, BatchOptions options = {})
+    {
+        using Argv = std::remove_cvref_t<std::ranges::range_reference_t<const Argvs>>;
+        constexpr bool is_views = std::ranges::contiguous_range<Argv>
+            && std::same_as<std::remove_cv_t<std::ranges::range_value_t<Argv>>, std::string_view>;
+
+        auto count = std::ranges::size(argvs);
+        if (output.size() < count) [[unlikely]]
+            return false;
+        auto threads = options.threads > 0 ? options.threads : std::max(std::thread::hardware_concurrency(), 1u);
+        options.parse.threads = 0;
+        options.parse.pool = nullptr;
+        // Command lines which are not contiguous views are copied as views in a buffer owned by each thread, reused
+        // from one command line to the next.
+        auto scratch = std::vector<std::vector<std::string_view>>(is_views ? 0 : threads);
+        auto first = std::ranges::begin(argvs);
+        impl::work_stealing_for(count, threads, options.chunk, [&](std::size_t worker, std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                const auto& argv = first[i];
+                if constexpr (is_views) {
+                    output[i] = glap::parser<Model>(impl::BiIterator(std::ranges::data(argv), std::ranges::data(argv) + std::ranges::size(argv)), options.parse);
+                } else {
+                    auto& args = scratch[worker];
+                    args.clear();
+                    for (auto&& arg : argv)
+                        args.emplace_back(arg);
+                    output[i] = glap::parser<Model>(impl::BiIterator(std::as_const(args).data(), std::as_const(args).data() + args.size()), options.parse);
+                }
+            }
+        });
+        return true;
+    }
+    /// Same as above, with `output` resized to the number of command lines first.
+    template <class Model, std::ranges::random_access_range Argvs>
+        requires std::ranges::sized_range<Argvs>
+            && impl::Range<std::ranges::range_reference_t<Argvs>, std::string_view>
+            && impl::ViewableArguments<std::ranges::range_reference_t<const Argvs>>
+    void parse_batch(const Argvs& argvs, std::vector<PosExpected<Model>>& output, BatchOptions options = {})
+    {
+        output.resize(std::ranges::size(argvs));
+        [[maybe_unused]] auto parsed = parse_batch<Model>(argvs, std::span(output), options);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#ifndef GLAP_MODULE
+#include "core/base.h"
+#include "help.h"
+#include <string_view>
+#endif
+
+GLAP_EXPORT namespace glap {
+    namespace completion {
+        /// Shells a completion script can be generated for
+        struct Bash {};
+        struct Zsh {};
+        struct Fish {};
+    }
+    /// Completion script of `FromParser` for `Shell`, described with `FromHelp` (or `void` for no description)
+    template<class Shell, class FromHelp, class FromParser>
+    struct Completion
+    {};
+
+    template<class Shell, class FromHelp, class FromParser>
+    inline constexpr auto get_completion = Completion<Shell, FromHelp, FromParser>{};
+    /// Completion script rendered at compile time, stored in read only data
+    template<class Shell, class FromHelp, class FromParser>
+    inline constexpr std::string_view completion_text = Completion<Shell, FromHelp, FromParser>::text();
+}
+
+#ifndef GLAP_MODULE
+#include "impl/completion.inl"
+#endif
\ No newline at end of file
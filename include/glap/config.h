@@ -0,0 +1,159 @@
+#pragma once
+
+#ifndef GLAP_MODULE
+#include "core/base.h"
+#include "core/error.h"
+#include "core/expected.h"
+#include "core/lookup.h"
+#include "core/utils.h"
+#include "environment.h"
+#include "mapped.h"
+#include "model.h"
+#include "parser.h"
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <variant>
+#include <vector>
+#endif
+
+GLAP_EXPORT namespace glap
+{
+    /// `key=value` configuration file, with optional `[command]` sections. Keys and values are views into the file.
+    class ConfigFile {
+    public:
+        struct Entry {
+            /// Section of the entry, empty before the first section
+            std::string_view section;
+            /// Long name of the argument, empty if the line is malformed
+            std::string_view key;
+            /// Value of the entry, none for a lone key (a flag). The malformed line itself if `key` is empty.
+            std::optional<std::string_view> value;
+            /// Line of the entry, starting at 1
+            std::size_t line;
+        };
+
+        /// Maps the file at `path` and reads its entries.
+        static auto open(const std::filesystem::path& path) -> expected<ConfigFile, std::error_code>;
+        /// Reads the entries of `content`, which must outlive the configuration.
+        static auto parse(std::string_view content) -> ConfigFile;
+
+        [[nodiscard]] auto entries() const noexcept -> std::span<const Entry> {
+            return m_entries;
+        }
+        /// Mapping the entries point into, if any.
+        [[nodiscard]] auto storage() const noexcept -> std::shared_ptr<const void> {
+            return m_file;
+        }
+    private:
+        ConfigFile() = default;
+
+        std::vector<Entry> m_entries;
+        std::shared_ptr<const MappedFile> m_file;
+    };
+}
+
+namespace glap::impl
+{
+    template <class Argument>
+    constexpr auto apply_config_value(Argument& argument, std::optional<std::string_view> value) -> Expected<void> {
+        if constexpr (model::IsArgumentTyped<Argument, model::ArgumentType::Flag>) {
+            auto flag = value ? env_flag_value(*value) : std::optional{true};
+            if (!flag) [[unlikely]] {
+                return make_unexpected(Error{
+                    .parameter = Argument::longname,
+                    .value = value,
+                    .type = Error::Type::Flag,
+                    .code = Error::Code::BadValidation
+                });
+            }
+            if (*flag)
+                return glap::parser<Argument>.parse(argument);
+            return {};
+        } else if constexpr (model::IsArgumentTyped<Argument, model::ArgumentType::Parameter>) {
+            if (!value) [[unlikely]] {
+                return make_unexpected(Error{
+                    .parameter = Argument::longname,
+                    .value = std::nullopt,
+                    .type = Error::Type::Parameter,
+                    .code = Error::Code::MissingValue
+                });
+            }
+            return glap::parser<Argument>.parse(argument, *value);
+        } else {
+            return make_unexpected(Error{
+                .parameter = std::string_view(),
+                .value = value,
+                .type = Error::Type::Input,
+                .code = Error::Code::UnknownArgument
+            });
+        }
+    }
+}
+
+GLAP_EXPORT namespace glap
+{
+    /// Sets the arguments left unset by the command line (and the environment) from the entries of `config` without
+    /// section or in the section named like the command. Entries are routed by long name.
+    /// Errors have the type `Error::Type::Config`, and the line of the entry as position.
+    template <class CommandNames, class... Arguments>
+    constexpr auto apply_config(model::Command<CommandNames, Arguments...>& command, const ConfigFile& config) -> PosExpected<void>
+    {
+        auto fail = [](Error error, const ConfigFile::Entry& entry) {
+            error.type = Error::Type::Config;
+            return make_unexpected(PositionnedError{
+                .error = error,
+                .position = static_cast<PositionnedError::difference_type>(entry.line)
+            });
+        };
+        auto set = std::apply([](const auto&... args) {
+            return std::array<bool, sizeof...(Arguments)>{impl::is_set(args)...};
+        }, command.arguments);
+        for (const auto& entry : config.entries()) {
+            if (!entry.section.empty() && entry.section != CommandNames::longname)
+                continue;
+            if (entry.key.empty()) [[unlikely]] {
+                return fail(Error{
+                    .parameter = std::string_view(),
+                    .value = entry.value,
+                    .type = Error::Type::None,
+                    .code = Error::Code::SyntaxError
+                }, entry);
+            }
+            auto index = impl::longname_table<Arguments...>.find(entry.key);
+            if (index == impl::npos_index) [[unlikely]] {
+                return fail(Error{
+                    .parameter = entry.key,
+                    .value = entry.value,
+                    .type = Error::Type::Unknown,
+                    .code = Error::Code::UnknownArgument
+                }, entry);
+            }
+            if (set[index])
+                continue;
+            Expected<void> res;
+            [&]<size_t ...I>(std::index_sequence<I...>) {
+                (void)((I == index && (res = impl::apply_config_value(std::get<I>(command.arguments), entry.value), true)) || ...);
+            }(std::index_sequence_for<Arguments...>{});
+            if (!res) [[unlikely]]
+                return fail(res.error(), entry);
+        }
+        return {};
+    }
+    /// Same as above, on the selected command of `program`. The program keeps the mapping of `config` alive, even on
+    /// error: the entries applied before the failing one stay in the command.
+    template <StringLiteral Name, model::DefaultCommand def_cmd, class... Commands>
+    constexpr auto apply_config(model::Program<Name, def_cmd, Commands...>& program, const ConfigFile& config) -> PosExpected<void>
+    {
+        if (config.storage())
+            program.storage.push_back(config.storage());
+        return std::visit([&config](auto& command) {
+            return apply_config(command, config);
+        }, program.command);
+    }
+}
\ No newline at end of file
@@ -3,125 +3,228 @@
 #ifndef GLAP_MODULE
 #include "base.h"
 #include "utils.h"
+#include <cassert>
 #include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
 #include <vector>
 #endif
 
 GLAP_EXPORT namespace glap
 {
+    /// Vector with a fixed capacity stored inline. Values are constructed in place when inserted, so unused slots are
+    /// never initialized and no allocation is ever made.
     template<typename T, size_t N>
     class StackVector {
-        T m_data[N];
-        size_t m_size = 0;
-
-        template <class Ty>
-        class _iterator {
-            StackVector<Ty, N>& array;
-            size_t index;
-        public:
-            constexpr _iterator(StackVector<T, N>& array, size_t index = 0) noexcept : array(array), index(index)
-            {}
-            constexpr _iterator& operator++() noexcept {
-                ++index;
-                return *this;
-            }
-            constexpr _iterator operator++(int) noexcept {
-                _iterator result(*this);
-                ++index;
-                return result;
-            }
-            constexpr bool operator==(const _iterator& other) const noexcept {
-                return &array == &other.array && index == other.index;
-            }
+        static_assert(N > 0, "StackVector capacity must be greater than 0");
+        union {
+            T m_data[N];
         };
+        size_t m_size = 0;
     public:
-        using iterator = _iterator<T>;
-        using const_iterator = _iterator<const T>;
         using value_type = T;
         using size_type = size_t;
         using difference_type = ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-        constexpr ~StackVector() requires std::destructible<T> {
-            if constexpr (!std::is_trivially_destructible_v<T>) {
-                for (size_t i = 0; i < m_size; ++i) {
-                    m_data[i].~T();
-                }
+        constexpr StackVector() noexcept
+        {}
+        constexpr StackVector(const StackVector& other) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+            for (const auto& value : other)
+                std::construct_at(m_data + m_size++, value);
+        }
+        constexpr StackVector(StackVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            for (auto& value : other)
+                std::construct_at(m_data + m_size++, std::move(value));
+        }
+        constexpr StackVector& operator=(const StackVector& other) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+            if (this != &other) {
+                clear();
+                for (const auto& value : other)
+                    std::construct_at(m_data + m_size++, value);
             }
-            m_size = 0;
+            return *this;
+        }
+        constexpr StackVector& operator=(StackVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            if (this != &other) {
+                clear();
+                for (auto& value : other)
+                    std::construct_at(m_data + m_size++, std::move(value));
+            }
+            return *this;
+        }
+        constexpr ~StackVector() {
+            clear();
+        }
+
+        /// Appends `value` if the vector is not full.
+        /// @return false if the vector is full, in which case nothing is inserted.
+        constexpr bool push_back(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+            if (m_size >= N) [[unlikely]]
+                return false;
+            std::construct_at(m_data + m_size++, value);
+            return true;
         }
-        constexpr void push_back(T value) noexcept {
-            m_data[m_size++] = value;
+        constexpr bool push_back(T&& value) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            if (m_size >= N) [[unlikely]]
+                return false;
+            std::construct_at(m_data + m_size++, std::move(value));
+            return true;
         }
+        /// Constructs a value at the end of the vector, which must not be full.
         template <class ...Args>
-        [[nodiscard]] constexpr T& emplace_back(Args... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) {
-            auto& current_data = m_data[m_size++];
-            new (current_data) T(args...);
-            return current_data;
+        constexpr T& emplace_back(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) {
+            assert(m_size < N && "StackVector is full");
+            return *std::construct_at(m_data + m_size++, std::forward<Args>(args)...);
         }
-        constexpr bool remove(size_t index) noexcept((!std::destructible<T> || std::is_nothrow_destructible_v<T>) && (!std::swappable<T> || std::is_nothrow_swappable_v<T>)) {
+        constexpr void pop_back() noexcept {
+            assert(m_size > 0 && "StackVector is empty");
+            std::destroy_at(m_data + --m_size);
+        }
+        /// Removes the value at `index`, replacing it by the last value (order is not preserved).
+        constexpr bool remove(size_t index) noexcept(std::is_nothrow_move_assignable_v<T>) {
             if (index >= m_size) {
                 return false;
             }
-            if constexpr (std::destructible<T>)
-                m_data[index].~T();
-            if constexpr(std::swappable<T>) {
-                using std::swap;
-                swap(m_data[m_size - 1], m_data[index]);
-            } else {
-                std::copy_n(reinterpret_cast<std::byte*>(&m_data[m_size - 1]), sizeof(T), reinterpret_cast<std::byte*>(&m_data[index]));
-            }
-            m_size--;
+            if (index != m_size - 1)
+                m_data[index] = std::move(m_data[m_size - 1]);
+            pop_back();
             return true;
         }
-        constexpr T& operator[](size_t index) {
+        constexpr void clear() noexcept {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                std::destroy(m_data, m_data + m_size);
+            m_size = 0;
+        }
+        constexpr T& operator[](size_t index) noexcept {
+            assert(index < m_size && "Index out of bounds");
             return m_data[index];
         }
-
-        constexpr const T& operator[](size_t index) const {
+        constexpr const T& operator[](size_t index) const noexcept {
+            assert(index < m_size && "Index out of bounds");
             return m_data[index];
         }
         [[nodiscard]] constexpr auto size() const noexcept {
             return m_size;
         }
-        [[nodiscard]] constexpr auto capacity() const noexcept {
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return m_size == 0;
+        }
+        [[nodiscard]] constexpr bool full() const noexcept {
+            return m_size == N;
+        }
+        [[nodiscard]] static constexpr auto capacity() noexcept {
             return N;
         }
+        [[nodiscard]] static constexpr auto max_size() noexcept {
+            return N;
+        }
+        [[nodiscard]] constexpr T* data() noexcept {
+            return m_data;
+        }
+        [[nodiscard]] constexpr const T* data() const noexcept {
+            return m_data;
+        }
         [[nodiscard]] constexpr auto& first() noexcept {
-            return m_data[0];
+            return (*this)[0];
         }
         [[nodiscard]] constexpr const auto& first() const noexcept {
-            return m_data[0];
+            return (*this)[0];
         }
         [[nodiscard]] constexpr auto& last() noexcept {
-            return m_data[m_size-1];
+            return (*this)[m_size - 1];
         }
         [[nodiscard]] constexpr const auto& last() const noexcept {
-            return m_data[m_size-1];
+            return (*this)[m_size - 1];
+        }
+        [[nodiscard]] constexpr auto& front() noexcept {
+            return first();
+        }
+        [[nodiscard]] constexpr const auto& front() const noexcept {
+            return first();
+        }
+        [[nodiscard]] constexpr auto& back() noexcept {
+            return last();
+        }
+        [[nodiscard]] constexpr const auto& back() const noexcept {
+            return last();
         }
 
         [[nodiscard]] constexpr auto begin() noexcept -> iterator {
-            return iterator(*this);
+            return m_data;
         }
         [[nodiscard]] constexpr auto end() noexcept -> iterator {
-            return iterator(*this, m_size);
+            return m_data + m_size;
         }
         [[nodiscard]] constexpr auto begin() const noexcept -> const_iterator {
-            return const_iterator(*this);
+            return m_data;
         }
         [[nodiscard]] constexpr auto end() const noexcept -> const_iterator {
-            return const_iterator(*this, m_size);
+            return m_data + m_size;
+        }
+        [[nodiscard]] constexpr auto cbegin() const noexcept -> const_iterator {
+            return begin();
+        }
+        [[nodiscard]] constexpr auto cend() const noexcept -> const_iterator {
+            return end();
         }
+        [[nodiscard]] constexpr auto rbegin() noexcept -> reverse_iterator {
+            return reverse_iterator(end());
+        }
+        [[nodiscard]] constexpr auto rend() noexcept -> reverse_iterator {
+            return reverse_iterator(begin());
+        }
+        [[nodiscard]] constexpr auto rbegin() const noexcept -> const_reverse_iterator {
+            return const_reverse_iterator(end());
+        }
+        [[nodiscard]] constexpr auto rend() const noexcept -> const_reverse_iterator {
+            return const_reverse_iterator(begin());
+        }
+    };
+}
+
+namespace glap::impl
+{
+    /// Type stored by a container of `T`: the value itself when it is arithmetic, `T` otherwise.
+    /// `bool` is excluded, vectors of it being packed bitsets.
+    template <class T>
+    struct StoredValue
+    {
+        using type = T;
     };
+    template <class T>
+        requires std::is_arithmetic_v<typename T::value_type> && (!std::is_same_v<typename T::value_type, bool>)
+    struct StoredValue<T>
+    {
+        using type = typename T::value_type;
+    };
+}
+
+GLAP_EXPORT namespace glap
+{
     template <class T, auto N = discard>
     class Container {
     public:
         using value_type = T;
+        /// Arithmetic values are stored contiguously as is, their presence being implied by the size
+        using stored_type = typename impl::StoredValue<T>::type;
+        static constexpr auto is_flat = !std::is_same_v<stored_type, T>;
     private:
         using n_type = std::remove_cvref_t<decltype(N)>;
         static constexpr auto is_n_discard = std::is_same_v<n_type, Discard>;
         static constexpr auto is_n_zero = impl::is_equal_v<N, 0>;
-        using dynamic_vector = std::vector<value_type>;
-        using stack_vector = StackVector<value_type, impl::value_or_v<N, 0>>;
+        using dynamic_vector = std::pmr::vector<stored_type>;
+        using stack_vector = StackVector<stored_type, impl::value_or_v<N, 0>>;
     public:
         using container_type = std::conditional_t<is_n_discard || is_n_zero, dynamic_vector, stack_vector>;
         container_type values;
@@ -129,28 +232,60 @@ GLAP_EXPORT namespace glap
         [[nodiscard]]constexpr auto size() const noexcept {
             return values.size();
         }
+        /// Reserves `capacity` values in the dynamic container. Does nothing on stack containers.
+        constexpr void reserve(size_t capacity) {
+            if constexpr(std::same_as<container_type, dynamic_vector>)
+                values.reserve(capacity);
+        }
+        /// Makes the dynamic container allocate from `resource`, and reserves `capacity` values in it.
+        /// Existing values are dropped. Does nothing on stack containers.
+        constexpr void use_resource(std::pmr::memory_resource* resource, size_t capacity) {
+            if constexpr(std::same_as<container_type, dynamic_vector>) {
+                std::destroy_at(&values);
+                std::construct_at(&values, resource);
+                values.reserve(capacity);
+            }
+        }
+
+        /// Value held by an element of `values`
+        [[nodiscard]] static constexpr auto& value_of(const stored_type& element) noexcept {
+            if constexpr (is_flat)
+                return element;
+            else
+                return *element.value;
+        }
+        [[nodiscard]] static constexpr auto& value_of(stored_type& element) noexcept {
+            if constexpr (is_flat)
+                return element;
+            else
+                return *element.value;
+        }
+        /// Contiguous view of arithmetic values
+        [[nodiscard]] constexpr auto span() const noexcept -> std::span<const stored_type> requires is_flat {
+            return std::span<const stored_type>(values.data(), values.size());
+        }
 
         [[nodiscard]]constexpr const auto& get(size_t i) const noexcept(noexcept(this->values[i])) {
-            if constexpr(std::same_as<container_type, stack_vector>) {
-                assert(i < impl::ValueOr<N, 0>::value, "Index out of bounds");
-            }
-            return this->values[i].value;
+            if constexpr (is_flat)
+                return this->values[i];
+            else
+                return this->values[i].value;
         }
         [[nodiscard]]constexpr auto& get(size_t i) noexcept(noexcept(this->values[i])) {
-            if constexpr(std::same_as<container_type, stack_vector>) {
-                assert(i < impl::ValueOr<N, 0>::value, "Index out of bounds");
-            }
-            return this->values[i].value;
+            if constexpr (is_flat)
+                return this->values[i];
+            else
+                return this->values[i].value;
         }
         template <size_t I>
         [[nodiscard]]constexpr auto& get() noexcept(noexcept(this->values[I])) {
             static_assert((std::same_as<container_type, stack_vector> && I < impl::ValueOr<N, 0>::value), "Index out of bounds");
-            return this->values[I].value;
+            return get(I);
         }
         template <size_t I>
         [[nodiscard]]constexpr const auto& get() const noexcept(noexcept(this->values[I])) {
             static_assert((std::same_as<container_type, stack_vector> && I < impl::ValueOr<N, 0>::value), "Index out of bounds");
-            return this->values[I].value;
+            return get(I);
         }
         [[nodiscard]]constexpr auto& operator[](size_t i) noexcept(noexcept(get(i))) {
             return get(i);
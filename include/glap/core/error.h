@@ -4,14 +4,18 @@
 #include "base.h"
 #include "expected.h"
 #include "fmt.h"
+#include <array>
 #include <string_view>
 #include <span>
 #include <algorithm>
+#include <memory>
 #include <optional>
 #endif
 
 GLAP_EXPORT namespace glap
 {
+    /// Known names close to a mistyped one, closest first; unused slots are empty
+    using Suggestions = std::array<std::string_view, 3>;
     struct Error {
         std::string_view parameter;
         std::optional<std::string_view> value;
@@ -21,7 +25,10 @@ GLAP_EXPORT namespace glap
             Flag,
             Input,
             None,
-            Unknown
+            Unknown,
+            Environment,
+            Config,
+            Snapshot
         } type;
         enum class Code {
             NoParameter,
@@ -36,8 +43,12 @@ GLAP_EXPORT namespace glap
             SyntaxError,
             BadString
         } code;
+        /// Names known where an unknown argument or command was given, see `suggestions`
+        std::span<const std::string_view> candidates = {};
 
         std::string to_string() const;
+        /// Candidates closest to `parameter`, searched on demand so that the parsing never pays for it
+        Suggestions suggestions() const;
     };
     template <class T>
     using Expected = expected<T, Error>;
@@ -45,6 +56,8 @@ GLAP_EXPORT namespace glap
         using difference_type = decltype(std::distance(std::span<std::string>().begin(), std::span<std::string>().end()));
         Error error;
         difference_type position;
+        /// Memory the error views point into (mapped argument files...), kept alive with the error.
+        std::shared_ptr<const void> storage = {};
         auto to_string() const {
             return glap::format("at parameter {}: {}", position, error.to_string());
         }
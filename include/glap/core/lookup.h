@@ -0,0 +1,126 @@
+#pragma once
+
+#ifndef GLAP_MODULE
+#include "base.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#endif
+
+GLAP_EXPORT namespace glap::impl
+{
+    inline constexpr size_t npos_index = static_cast<size_t>(-1);
+
+    /// FNV-1a hash of a name, usable at compile time
+    [[nodiscard]] constexpr std::uint32_t hash_name(std::string_view name) noexcept {
+        std::uint32_t hash = 2166136261u;
+        for (auto c : name) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    /// Hash table of long names built at compile time.
+    /// The table is at most half full, so a lookup is one hash and, in most cases, one string comparison.
+    /// `find` returns the index of the name in the list given at construction, or `npos_index`.
+    template <size_t N>
+    class LongNameTable {
+        static constexpr size_t table_size = std::bit_ceil(N > 0 ? N * 2 : 1);
+        static constexpr size_t mask = table_size - 1;
+        /// `index` is the name index plus one, so a zero-initialized slot is empty
+        struct Slot {
+            std::string_view name;
+            std::uint32_t hash = 0;
+            size_t index = 0;
+        };
+        std::array<Slot, table_size> slots = {};
+    public:
+        constexpr LongNameTable(const std::array<std::optional<std::string_view>, N>& names) noexcept {
+            for (size_t i = 0; i < N; ++i) {
+                if (!names[i])
+                    continue;
+                auto hash = hash_name(*names[i]);
+                auto pos = hash & mask;
+                while (slots[pos].index != 0)
+                    pos = (pos + 1) & mask;
+                slots[pos] = Slot{*names[i], hash, i + 1};
+            }
+        }
+        [[nodiscard]] constexpr size_t find(std::string_view name) const noexcept {
+            auto hash = hash_name(name);
+            for (auto pos = hash & mask; slots[pos].index != 0; pos = (pos + 1) & mask) {
+                if (slots[pos].hash == hash && slots[pos].name == name)
+                    return slots[pos].index - 1;
+            }
+            return npos_index;
+        }
+    };
+
+    /// Short name table built at compile time.
+    /// ASCII code points are resolved with a direct table load, others with a binary search over the sorted
+    /// non-ASCII short names.
+    /// `find` returns the index of the code point in the list given at construction, or `npos_index`.
+    template <size_t N>
+    class ShortNameTable {
+        struct Entry {
+            char32_t codepoint = 0;
+            size_t index = npos_index;
+        };
+        std::array<size_t, 128> ascii;
+        std::array<Entry, N> others = {};
+        size_t nb_others = 0;
+    public:
+        constexpr ShortNameTable(const std::array<std::optional<char32_t>, N>& codepoints) noexcept {
+            ascii.fill(npos_index);
+            for (size_t i = 0; i < N; ++i) {
+                if (!codepoints[i])
+                    continue;
+                if (*codepoints[i] < ascii.size())
+                    ascii[*codepoints[i]] = i;
+                else
+                    others[nb_others++] = Entry{*codepoints[i], i};
+            }
+            std::sort(others.begin(), others.begin() + nb_others, [](const Entry& a, const Entry& b) {
+                return a.codepoint < b.codepoint;
+            });
+        }
+        [[nodiscard]] constexpr size_t find(char32_t codepoint) const noexcept {
+            if (codepoint < ascii.size()) [[likely]]
+                return ascii[codepoint];
+            auto end = others.begin() + nb_others;
+            auto it = std::lower_bound(others.begin(), end, codepoint, [](const Entry& entry, char32_t value) {
+                return entry.codepoint < value;
+            });
+            if (it == end || it->codepoint != codepoint)
+                return npos_index;
+            return it->index;
+        }
+    };
+
+    template <class T>
+    constexpr auto longname_of() noexcept -> std::optional<std::string_view> {
+        if constexpr (HasLongName<T>)
+            return T::longname;
+        else
+            return std::nullopt;
+    }
+    /// Long name table of a list of model types. Types without long name (inputs) are skipped.
+    template <class ...T>
+    inline constexpr auto longname_table = LongNameTable<sizeof...(T)>(std::array<std::optional<std::string_view>, sizeof...(T)>{longname_of<T>()...});
+    template <class T>
+    constexpr auto shortname_of() noexcept -> std::optional<char32_t> {
+        if constexpr (HasNames<T>)
+            return T::shortname;
+        else
+            return std::nullopt;
+    }
+    /// Short name table of a list of model types. Types without short name are skipped.
+    template <class ...T>
+    inline constexpr auto shortname_table = ShortNameTable<sizeof...(T)>(std::array<std::optional<char32_t>, sizeof...(T)>{shortname_of<T>()...});
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+#pragma once
+
+#ifndef GLAP_MODULE
+#include "base.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#endif
+
+GLAP_EXPORT namespace glap::impl
+{
+    /// Runs `work(begin, end)` over chunks of `[0, count)` on `threads` threads, the calling thread included.
+    /// Threads take the next chunk from a shared counter, so the fastest threads take the most chunks.
+    /// `work` must not throw.
+    template <class Work>
+    void parallel_for(std::size_t count, unsigned threads, Work&& work, std::size_t chunk = 0)
+    {
+        threads = std::max(threads, 1u);
+        if (chunk == 0)
+            chunk = std::max<std::size_t>(1, count / (threads * 8));
+        std::atomic<std::size_t> next = 0;
+        auto run = [&] {
+            for (;;) {
+                auto begin = next.fetch_add(chunk, std::memory_order_relaxed);
+                if (begin >= count)
+                    return;
+                work(begin, std::min(begin + chunk, count));
+            }
+        };
+        auto nb_workers = std::min<std::size_t>(threads, (count + chunk - 1) / chunk);
+        std::vector<std::jthread> workers;
+        workers.reserve(nb_workers > 0 ? nb_workers - 1 : 0);
+        for (std::size_t i = 1; i < nb_workers; ++i)
+            workers.emplace_back(run);
+        run();
+    }
+    /// Runs `work(worker, begin, end)` over chunks of `[0, count)` on `threads` threads, the calling thread included
+    /// with the worker index 0.
+    /// Each worker owns a contiguous block of the range and takes its chunks in order. Once its block is done, it
+    /// steals chunks from the blocks of the other workers. `work` must not throw.
+    template <class Work>
+    void work_stealing_for(std::size_t count, unsigned threads, std::size_t chunk, Work&& work)
+    {
+        struct alignas(64) Block {
+            std::atomic<std::size_t> next;
+            std::size_t end;
+        };
+        chunk = std::max<std::size_t>(chunk, 1);
+        auto nb_workers = std::max<std::size_t>(1, std::min<std::size_t>(std::max(threads, 1u), (count + chunk - 1) / chunk));
+        auto blocks = std::make_unique<Block[]>(nb_workers);
+        for (std::size_t w = 0; w < nb_workers; ++w) {
+            blocks[w].next.store(count * w / nb_workers, std::memory_order_relaxed);
+            blocks[w].end = count * (w + 1) / nb_workers;
+        }
+        auto run = [&](std::size_t worker) {
+            for (std::size_t i = 0; i < nb_workers; ++i) {
+                auto& block = blocks[(worker + i) % nb_workers];
+                for (;;) {
+                    auto begin = block.next.fetch_add(chunk, std::memory_order_relaxed);
+                    if (begin >= block.end)
+                        break;
+                    work(worker, begin, std::min(begin + chunk, block.end));
+                }
+            }
+        };
+        std::vector<std::jthread> workers;
+        workers.reserve(nb_workers - 1);
+        for (std::size_t w = 1; w < nb_workers; ++w)
+            workers.emplace_back(run, w);
+        run(0);
+    }
+}
+
+GLAP_EXPORT namespace glap
+{
+    /// Worker threads started once and reused by every job given to them, for instance by the parsings sharing it
+    /// through `ParseOptions::pool`.
+    /// A job runs on the workers and on the thread submitting it. Jobs submitted concurrently run one after another.
+    class ThreadPool {
+    public:
+        /// Starts `threads - 1` workers, so that a job runs on `threads` threads with the submitting one.
+        /// 0 uses every hardware thread.
+        explicit ThreadPool(unsigned threads = 0);
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ~ThreadPool();
+
+        /// Number of threads running a job, the submitting one included
+        [[nodiscard]] unsigned size() const noexcept {
+            return static_cast<unsigned>(m_workers.size()) + 1;
+        }
+        /// Runs `work(begin, end)` over chunks of `[0, count)` on the threads of the pool, like `impl::parallel_for`,
+        /// and returns once every chunk is done. `work` must not throw.
+        template <class Work>
+        void parallel_for(std::size_t count, Work&& work, std::size_t chunk = 0) {
+            using WorkType = std::remove_reference_t<Work>;
+            run(count, chunk, [](void* context, std::size_t begin, std::size_t end) {
+                (*static_cast<WorkType*>(context))(begin, end);
+            }, const_cast<void*>(static_cast<const void*>(std::addressof(work))));
+        }
+    private:
+        using Job = void(*)(void*, std::size_t, std::size_t);
+        void run(std::size_t count, std::size_t chunk, Job job, void* context);
+        void run_chunks() noexcept;
+        void worker_loop() noexcept;
+
+        /// Held by the submitting thread for the whole job
+        std::mutex m_submit;
+        /// Guards the job fields, `m_generation`, `m_active` and `m_stop`
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        Job m_job = nullptr;
+        void* m_context = nullptr;
+        std::size_t m_count = 0;
+        std::size_t m_chunk = 1;
+        std::atomic<std::size_t> m_next = 0;
+        /// Incremented for each job, so that a worker runs it once
+        std::size_t m_generation = 0;
+        /// Workers which have not finished the current job
+        std::size_t m_active = 0;
+        bool m_stop = false;
+        std::vector<std::jthread> m_workers;
+    };
+}
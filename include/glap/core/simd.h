@@ -0,0 +1,12 @@
+#pragma once
+
+// Instruction sets usable by the library, selected at compile time.
+// Nothing is detected at runtime: the library follows the target flags given to the compiler (e.g. -mavx2).
+#if !defined(GLAP_NO_SIMD)
+#   if defined(__AVX2__)
+#       define GLAP_SIMD_AVX2
+#       define GLAP_SIMD_SSE2
+#   elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define GLAP_SIMD_SSE2
+#   endif
+#endif
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#ifndef GLAP_MODULE
+#include "base.h"
+#include "error.h"
+#include "lookup.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#endif
+
+GLAP_EXPORT namespace glap::impl
+{
+    /// Bit-parallel Levenshtein distance (Myers, Hyyrö) between a pattern of at most 64 bytes and any text.
+    /// The pattern bitmasks are built once, then each text costs a few word operations per byte.
+    class EditDistance {
+        std::array<std::uint64_t, 256> peq = {};
+        std::uint64_t last = 0;
+        size_t length = 0;
+    public:
+        static constexpr size_t max_pattern_length = 64;
+
+        constexpr EditDistance(std::string_view pattern) noexcept : length(pattern.size()) {
+            for (size_t i = 0; i < pattern.size(); ++i)
+                peq[static_cast<unsigned char>(pattern[i])] |= std::uint64_t{1} << i;
+            if (length > 0)
+                last = std::uint64_t{1} << (length - 1);
+        }
+        [[nodiscard]] constexpr size_t operator()(std::string_view text) const noexcept {
+            if (length == 0)
+                return text.size();
+            std::uint64_t pv = ~std::uint64_t{0};
+            std::uint64_t mv = 0;
+            auto score = length;
+            for (auto c : text) {
+                auto eq = peq[static_cast<unsigned char>(c)];
+                auto xv = eq | mv;
+                auto xh = (((eq & pv) + pv) ^ pv) | eq;
+                auto ph = mv | ~(xh | pv);
+                auto mh = pv & xh;
+                if (ph & last)
+                    ++score;
+                else if (mh & last)
+                    --score;
+                ph = (ph << 1) | 1;
+                mh <<= 1;
+                pv = mh | ~(xv | ph);
+                mv = ph & xv;
+            }
+            return score;
+        }
+    };
+
+    /// Names of `candidates` closest to `name`, closest first. Empty names are skipped.
+    /// A name is suggested when at most a third of `name` (and at least 2 bytes) has to be edited, and not all of it.
+    /// `name` itself is never suggested.
+    [[nodiscard]] constexpr auto suggest(std::string_view name, std::span<const std::string_view> candidates) noexcept -> Suggestions {
+        auto result = Suggestions{};
+        if (name.empty() || name.size() > EditDistance::max_pattern_length)
+            return result;
+        auto distance_to = EditDistance(name);
+        auto max_distance = std::max<size_t>(2, name.size() / 3);
+        std::array<size_t, std::tuple_size_v<Suggestions>> distances = {};
+        size_t count = 0;
+        for (auto candidate : candidates) {
+            if (candidate.empty())
+                continue;
+            auto distance = distance_to(candidate);
+            if (distance == 0 || distance > max_distance || distance >= candidate.size())
+                continue;
+            auto pos = count;
+            while (pos > 0 && distances[pos - 1] > distance)
+                --pos;
+            if (pos == result.size())
+                continue;
+            count = std::min(count + 1, result.size());
+            for (auto i = count - 1; i > pos; --i) {
+                result[i] = result[i - 1];
+                distances[i] = distances[i - 1];
+            }
+            result[pos] = candidate;
+            distances[pos] = distance;
+        }
+        return result;
+    }
+
+    /// Long names of a list of model types, in declaration order. Types without long name have an empty name.
+    template <class ...T>
+    inline constexpr auto longname_list = std::array<std::string_view, sizeof...(T)>{longname_of<T>().value_or(std::string_view{})...};
+}
\ No newline at end of file
@@ -1,11 +1,22 @@
 #pragma once
 
+#include "simd.h"
 #ifndef GLAP_MODULE
 #include "base.h"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <string_view>
 #include <string>
+#include <type_traits>
 #include "expected.h"
+#if defined(GLAP_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(GLAP_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
 #endif
 
 GLAP_EXPORT namespace glap::utils::uni {
@@ -18,81 +29,198 @@ GLAP_EXPORT namespace glap::utils::uni {
     };
     template <class T>
     using Expected = expected<T, UnicodeError>;
+    namespace impl {
+        struct Utf8Lead {
+            std::uint8_t length = 0;
+            std::uint8_t second_min = 0x80;
+            std::uint8_t second_max = 0xBF;
+        };
+        /// Well-formed UTF-8 byte sequences (Unicode Table 3-7) indexed by lead byte:
+        /// sequence length (0 if the byte cannot start a sequence) and range of the second byte.
+        /// The ranges reject overlong forms, surrogates and code points above U+10FFFF.
+        inline constexpr auto utf8_leads = [] {
+            std::array<Utf8Lead, 256> leads = {};
+            for (size_t c = 0x00; c <= 0x7F; ++c)
+                leads[c] = {1, 0x00, 0xFF};
+            for (size_t c = 0xC2; c <= 0xDF; ++c)
+                leads[c] = {2, 0x80, 0xBF};
+            for (size_t c = 0xE0; c <= 0xEF; ++c)
+                leads[c] = {3, 0x80, 0xBF};
+            leads[0xE0].second_min = 0xA0;
+            leads[0xED].second_max = 0x9F;
+            for (size_t c = 0xF0; c <= 0xF4; ++c)
+                leads[c] = {4, 0x80, 0xBF};
+            leads[0xF0].second_min = 0x90;
+            leads[0xF4].second_max = 0x8F;
+            return leads;
+        }();
+        /// Length of the well-formed UTF-8 sequence at the beginning of `str`, 0 if it is malformed or truncated.
+        [[nodiscard]] constexpr size_t utf8_sequence_length(std::string_view str) noexcept {
+            if (str.empty())
+                return 0;
+            auto lead = utf8_leads[static_cast<unsigned char>(str[0])];
+            if (lead.length == 1)
+                return 1;
+            if (lead.length == 0 || str.size() < lead.length)
+                return 0;
+            auto second = static_cast<unsigned char>(str[1]);
+            if (second < lead.second_min || second > lead.second_max)
+                return 0;
+            for (size_t i = 2; i < lead.length; ++i) {
+                if ((static_cast<unsigned char>(str[i]) & 0xC0) != 0x80)
+                    return 0;
+            }
+            return lead.length;
+        }
+        /// Number of ASCII bytes at the beginning of `str`, checked 32 (AVX2) or 16 (SSE2) bytes at a time.
+        [[nodiscard]] inline size_t ascii_prefix_length(std::string_view str) noexcept {
+            size_t i = 0;
+        #if defined(GLAP_SIMD_AVX2)
+            for (; i + 32 <= str.size(); i += 32) {
+                auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str.data() + i));
+                auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(block));
+                if (mask != 0)
+                    return i + std::countr_zero(mask);
+            }
+        #endif
+        #if defined(GLAP_SIMD_SSE2)
+            for (; i + 16 <= str.size(); i += 16) {
+                auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + i));
+                auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(block));
+                if (mask != 0)
+                    return i + std::countr_zero(mask);
+            }
+        #endif
+            while (i < str.size() && static_cast<unsigned char>(str[i]) < 0x80)
+                ++i;
+            return i;
+        }
+    }
     [[nodiscard]] constexpr Expected<std::uint8_t> utf8_char_length(std::string_view str) noexcept {
-        auto c = str.front();
-        if ((c & 0x80) == 0) {
-            return 1;
-        } else if ((c & 0xE0) == 0xC0) {
-            return 2;
-        } else if ((c & 0xF0) == 0xE0) {
-            return 3;
-        } else if ((c & 0xF8) == 0xF0) {
-            return 4;
-        } else {
+        if (str.empty() || impl::utf8_leads[static_cast<unsigned char>(str.front())].length == 0) {
             return unexpected<UnicodeError>(UnicodeError{
                 .str = str,
                 .pos = 0,
                 .error = UnicodeError::Error::InvalidUtf8Char
             });
         }
+        return impl::utf8_leads[static_cast<unsigned char>(str.front())].length;
     }
-    [[nodiscard]] constexpr Expected<size_t> utf8_length(std::string_view str) noexcept {
-        std::uint8_t len = 0;
-        for (auto itChar = str.data(); itChar != str.data()+str.size();) {
-            auto char_len = utf8_char_length(std::string_view{itChar, 1});
-            if (!char_len) {
-                auto error = std::move(char_len.error());
-                error.pos = std::distance(str.data(), itChar);
-                return unexpected<UnicodeError>(std::move(error));
+    /// Checks that `str` is well-formed UTF-8.
+    /// On error, `pos` is the byte offset of the first malformed sequence.
+    [[nodiscard]] constexpr Expected<void> utf8_validate(std::string_view str) noexcept {
+        size_t pos = 0;
+        while (pos < str.size()) {
+            if (!std::is_constant_evaluated() && static_cast<unsigned char>(str[pos]) < 0x80) {
+                pos += impl::ascii_prefix_length(str.substr(pos));
+                continue;
             }
-            len += 1;
-            itChar += char_len.value();
+            auto char_len = impl::utf8_sequence_length(str.substr(pos));
+            if (char_len == 0) {
+                return unexpected<UnicodeError>(UnicodeError{
+                    .str = str.substr(pos, 1),
+                    .pos = pos,
+                    .error = UnicodeError::Error::InvalidUtf8Char
+                });
+            }
+            pos += char_len;
         }
-        return len;
+        return {};
+    }
+    /// Number of code points in `str`, which is expected to be well-formed UTF-8 (see `utf8_validate`).
+    /// Counts the bytes which are not continuation bytes (10xxxxxx), 8 bytes at a time: each byte lane of `lanes`
+    /// accumulates up to 255 words before the lanes are summed.
+    [[nodiscard]] constexpr size_t utf8_count(std::string_view str) noexcept {
+        constexpr auto low_bits = std::uint64_t{0x0101010101010101};
+        size_t count = 0;
+        size_t i = 0;
+        if (!std::is_constant_evaluated()) {
+            while (i + 8 <= str.size()) {
+                std::uint64_t lanes = 0;
+                for (size_t words = 0; words < 255 && i + 8 <= str.size(); ++words, i += 8) {
+                    std::uint64_t word;
+                    std::memcpy(&word, str.data() + i, 8);
+                    lanes += ((~word >> 7) | (word >> 6)) & low_bits;
+                }
+                auto pairs = (lanes & 0x00FF00FF00FF00FF) + ((lanes >> 8) & 0x00FF00FF00FF00FF);
+                count += static_cast<size_t>((pairs * 0x0001000100010001) >> 48);
+            }
+        }
+        for (; i < str.size(); ++i) {
+            if ((static_cast<unsigned char>(str[i]) & 0xC0) != 0x80)
+                ++count;
+        }
+        return count;
+    }
+    /// Number of code points in `str`, or an error if `str` is not well-formed UTF-8.
+    [[nodiscard]] constexpr Expected<size_t> utf8_length(std::string_view str) noexcept {
+        auto valid = utf8_validate(str);
+        if (!valid)
+            return unexpected<UnicodeError>(std::move(valid.error()));
+        return utf8_count(str);
     }
     [[nodiscard]] constexpr Expected<char32_t> codepoint(std::string_view utf8) noexcept {
-        char32_t codepoint = 0;
-        auto it = utf8.begin();
-        if ((*it & 0x80) == 0) {
-            codepoint = *it;
-        } else if ((*it & 0xE0) == 0xC0) {
-            codepoint = (*it & 0x1F) << 6;
-            codepoint |= *(++it) & 0x3F;
-        } else if ((*it & 0xF0) == 0xE0) {
-            codepoint = (*it & 0x0F) << 12;
-            codepoint |= (*(++it) & 0x3F) << 6;
-            codepoint |= *(++it) & 0x3F;
-        } else if ((*it & 0xF8) == 0xF0) {
-            codepoint = (*it & 0x07) << 18;
-            codepoint |= (*(++it) & 0x3F) << 12;
-            codepoint |= (*(++it) & 0x3F) << 6;
-            codepoint |= *(++it) & 0x3F;
-        } else {
+        auto length = impl::utf8_sequence_length(utf8);
+        if (length == 0) {
             return unexpected<UnicodeError>(UnicodeError{
                 .str = utf8,
                 .pos = 0,
                 .error = UnicodeError::Error::InvalidUtf8Char
             });
         }
-        return codepoint;
+        auto byte = [utf8](size_t i) {
+            return static_cast<char32_t>(static_cast<unsigned char>(utf8[i]));
+        };
+        switch (length) {
+            case 1:
+                return byte(0);
+            case 2:
+                return (byte(0) & 0x1F) << 6 | (byte(1) & 0x3F);
+            case 3:
+                return (byte(0) & 0x0F) << 12 | (byte(1) & 0x3F) << 6 | (byte(2) & 0x3F);
+            default:
+                return (byte(0) & 0x07) << 18 | (byte(1) & 0x3F) << 12 | (byte(2) & 0x3F) << 6 | (byte(3) & 0x3F);
+        }
     }
-    [[nodiscard]] constexpr std::string codepoint_to_utf8(char32_t codepoint) noexcept {
-        std::string utf8;
+    /// Decodes the code point at byte offset `pos` of `str` and moves `pos` after it.
+    /// ASCII characters are read directly, without going through the UTF-8 tables.
+    [[nodiscard]] constexpr Expected<char32_t> next_codepoint(std::string_view str, size_t& pos) noexcept {
+        auto lead = static_cast<unsigned char>(str[pos]);
+        if (lead < 0x80) [[likely]] {
+            ++pos;
+            return static_cast<char32_t>(lead);
+        }
+        auto res = codepoint(str.substr(pos));
+        if (res)
+            pos += impl::utf8_leads[lead].length;
+        return res;
+    }
+    /// Writes the UTF-8 encoding of `codepoint` in `out` (4 bytes at most), and returns its length.
+    /// Code points above U+10FFFF are not written.
+    constexpr size_t codepoint_to_utf8(char32_t codepoint, char* out) noexcept {
         if (codepoint <= 0x7F) {
-            utf8.push_back(static_cast<char>(codepoint));
+            out[0] = static_cast<char>(codepoint);
+            return 1;
         } else if (codepoint <= 0x7FF) {
-            utf8.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
-            utf8.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+            out[0] = static_cast<char>(0xC0 | (codepoint >> 6));
+            out[1] = static_cast<char>(0x80 | (codepoint & 0x3F));
+            return 2;
         } else if (codepoint <= 0xFFFF) {
-            utf8.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
-            utf8.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
-            utf8.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+            out[0] = static_cast<char>(0xE0 | (codepoint >> 12));
+            out[1] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            out[2] = static_cast<char>(0x80 | (codepoint & 0x3F));
+            return 3;
         } else if (codepoint <= 0x10FFFF) {
-            utf8.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
-            utf8.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
-            utf8.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
-            utf8.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+            out[0] = static_cast<char>(0xF0 | (codepoint >> 18));
+            out[1] = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+            out[2] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            out[3] = static_cast<char>(0x80 | (codepoint & 0x3F));
+            return 4;
         }
-        return utf8;
+        return 0;
+    }
+    [[nodiscard]] constexpr std::string codepoint_to_utf8(char32_t codepoint) noexcept {
+        char utf8[4] = {};
+        return std::string(utf8, codepoint_to_utf8(codepoint, utf8));
     }
 }
\ No newline at end of file
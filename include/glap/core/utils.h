@@ -2,6 +2,7 @@
 
 #ifndef GLAP_MODULE
 #include "base.h"
+#include <array>
 #include <concepts>
 #include <optional>
 #include <string_view>
@@ -100,6 +101,13 @@ GLAP_EXPORT namespace glap {
         && std::same_as<std::remove_cvref_t<decltype(T::shortname)>, std::optional<char32_t>>;
     template <typename T>
     concept HasShortName = HasNames<T> && T::shortname.has_value();
+    /// Names of an argument also set by the environment variable `EnvName` (see `apply_environment`)
+    template <class ArgNames, StringLiteral EnvName>
+    struct Env : ArgNames {
+        static constexpr std::string_view envname = EnvName;
+    };
+    template <typename T>
+    concept HasEnvName = std::same_as<std::remove_cvref_t<decltype(T::envname)>, std::string_view>;
     template <typename T>
     concept IsResolver = std::invocable<T, std::string_view>;
     template <typename T>
@@ -108,29 +116,30 @@ GLAP_EXPORT namespace glap {
 
 namespace glap::impl
 {
+    template <class T>
+    inline constexpr std::string_view checked_longname = {};
+    template <HasNames T>
+    inline constexpr std::string_view checked_longname<T> = T::longname;
+    template <class T>
+    inline constexpr std::optional<char32_t> checked_shortname = std::nullopt;
+    template <HasNames T>
+    inline constexpr std::optional<char32_t> checked_shortname<T> = T::shortname;
+
+    /// Whether two set values of `values` are equal: the values are sorted, then compared with their neighbour
+    template <class T, size_t N>
+    consteval auto has_duplicate(std::array<T, N> values) -> bool {
+        std::sort(values.begin(), values.end());
+        return std::adjacent_find(values.begin(), values.end(), [](const T& a, const T& b) {
+            return a == b && a != T{};
+        }) != values.end();
+    }
+    /// Duplicate names among a list of model types, checked in one pass over the sorted names. Types without names
+    /// (inputs) are skipped.
     template <class ...ArgN>
     struct NameChecker
     {
-        static constexpr bool has_duplicate_longname = false;
-        static constexpr bool has_duplicate_shortname = false;
-    };
-    template <HasNames Arg1, HasNames Arg2, class ...ArgN>
-    struct NameChecker<Arg1, Arg2, ArgN...>
-    {
-        static constexpr bool has_duplicate_longname = Arg1::longname == Arg2::longname || NameChecker<Arg1, ArgN...>::has_duplicate_longname || NameChecker<Arg2, ArgN...>::has_duplicate_longname;
-        static constexpr bool has_duplicate_shortname = (Arg1::shortname.has_value() && Arg2::shortname.has_value() && Arg1::shortname.value() == Arg2::shortname.value()) || NameChecker<Arg1, ArgN...>::has_duplicate_shortname || NameChecker<Arg2, ArgN...>::has_duplicate_shortname;
-    };
-    template <typename Arg1, typename Arg2, class ...ArgN>
-        requires HasNames<Arg1> && (!HasNames<Arg2>)
-    struct NameChecker<Arg1, Arg2, ArgN...>
-    {
-        static constexpr bool has_duplicate_longname = NameChecker<Arg1, ArgN...>::has_duplicate_longname;
-        static constexpr bool has_duplicate_shortname = NameChecker<Arg1, ArgN...>::has_duplicate_shortname;
-    };
-    template <typename Arg1, class ...ArgN>
-    struct NameChecker<Arg1, Arg1, ArgN...>
-    {
-        static_assert(!std::is_same_v<Arg1, Arg1>, "Duplicate argument");
+        static constexpr bool has_duplicate_longname = has_duplicate(std::array<std::string_view, sizeof...(ArgN)>{checked_longname<ArgN>...});
+        static constexpr bool has_duplicate_shortname = has_duplicate(std::array<std::optional<char32_t>, sizeof...(ArgN)>{checked_shortname<ArgN>...});
     };
     template <class T>
     struct ResolverReturnType
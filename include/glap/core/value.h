@@ -3,18 +3,127 @@
 #ifndef GLAP_MODULE
 #include "base.h"
 #include "discard.h"
+#include "error.h"
+#include "expected.h"
 #include "utils.h"
 #include <string_view>
 #include <optional>
+#include <utility>
 #endif
 
 GLAP_EXPORT namespace glap
 {
+    /// Marks a resolver as lazy: the value is stored raw and resolved on first access (see LazyValue).
+    template <auto Resolver = discard>
+    struct Lazy {
+        static constexpr auto resolver = Resolver;
+    };
+    template <auto Resolver = discard>
+    inline constexpr auto lazy = Lazy<Resolver>{};
+
+    template <auto Resolver, auto Validator>
+    class LazyValue;
+}
+
+namespace glap::impl
+{
+    template <class T>
+    struct IsLazy : std::false_type
+    {};
+    template <auto Resolver>
+    struct IsLazy<Lazy<Resolver>> : std::true_type
+    {};
+    template <class T>
+    struct IsLazyValue : std::false_type
+    {};
+    template <auto Resolver, auto Validator>
+    struct IsLazyValue<LazyValue<Resolver, Validator>> : std::true_type
+    {};
+    template <auto Resolver, auto Validator>
+    struct ValueType
+    {
+        using type = typename ResolverReturnType<decltype(Resolver)>::type;
+    };
+    template <auto Resolver, auto Validator>
+        requires IsLazy<std::remove_cv_t<decltype(Resolver)>>::value
+    struct ValueType<Resolver, Validator>
+    {
+        using type = LazyValue<Resolver.resolver, Validator>;
+    };
+    /// Type of the value stored by an argument with this resolver and validator
+    template <auto Resolver, auto Validator>
+    using value_type_t = typename ValueType<Resolver, Validator>::type;
+}
+
+GLAP_EXPORT namespace glap
+{
+    template <class OutputType, auto Resolver, auto Validator>
+    constexpr auto check_value(std::string_view value) -> Expected<OutputType>
+    {
+        if constexpr (impl::IsLazy<std::remove_cv_t<decltype(Resolver)>>::value) {
+            return OutputType(value);
+        } else {
+            if constexpr (IsValidator<decltype(Validator)>) {
+                if (!Validator(value)) [[unlikely]] {
+                    return make_unexpected(Error{
+                        .parameter = std::string_view(),
+                        .value = value,
+                        .type = Error::Type::Parameter,
+                        .code = Error::Code::BadValidation
+                    });
+                }
+            }
+            if constexpr (IsResolver<decltype(Resolver)>) {
+                auto result = Resolver(value);
+                if constexpr (IsExpected<decltype(result)>) {
+                    if (!result) [[unlikely]] {
+                        return make_unexpected(Error{
+                            .parameter = std::string_view(),
+                            .value = value,
+                            .type = Error::Type::Parameter,
+                            .code = Error::Code::BadResolution
+                        });
+                    }
+                    return std::move(*result);
+                } else {
+                    return result;
+                }
+            } else {
+                return value;
+            }
+        }
+    }
+
+    /// Raw value validated and resolved on first call to `get`, then memoized.
+    /// `get` is not thread safe.
+    template <auto Resolver, auto Validator>
+    class LazyValue {
+    public:
+        using value_type = typename impl::ResolverReturnType<decltype(Resolver)>::type;
+
+        constexpr LazyValue(std::string_view raw) noexcept : m_raw(raw)
+        {}
+        [[nodiscard]] constexpr std::string_view raw() const noexcept {
+            return m_raw;
+        }
+        [[nodiscard]] constexpr bool resolved() const noexcept {
+            return m_resolved.has_value();
+        }
+        [[nodiscard]] constexpr auto get() const -> const Expected<value_type>& {
+            if (!m_resolved)
+                m_resolved = check_value<value_type, Resolver, Validator>(m_raw);
+            return *m_resolved;
+        }
+    private:
+        std::string_view m_raw;
+        mutable std::optional<Expected<value_type>> m_resolved;
+    };
+
     template <auto Resolver = discard, auto Validator = discard>
     struct Value {
-        using value_type = typename impl::ResolverReturnType<decltype(Resolver)>::type;
+        using value_type = impl::value_type_t<Resolver, Validator>;
         constexpr Value() = default;
-        constexpr Value(std::string_view v) : value(v)
+        constexpr Value(value_type v) : value(std::move(v))
         {}
         
         static constexpr auto resolver = Resolver;
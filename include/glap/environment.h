@@ -0,0 +1,120 @@
+#pragma once
+
+#ifndef GLAP_MODULE
+#include "core/base.h"
+#include "core/error.h"
+#include "core/lookup.h"
+#include "core/utils.h"
+#include "model.h"
+#include "parser.h"
+#include <array>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <variant>
+#endif
+
+namespace glap::impl
+{
+    /// Environment of the process (`environ`)
+    auto environment() noexcept -> const char* const*;
+
+    template <class T>
+    constexpr auto envname_of() noexcept -> std::optional<std::string_view> {
+        if constexpr (HasEnvName<T>)
+            return T::envname;
+        else
+            return std::nullopt;
+    }
+    /// Environment variable name table of a list of model types. Types without environment variable are skipped.
+    template <class ...T>
+    inline constexpr auto envname_table = LongNameTable<sizeof...(T)>(std::array<std::optional<std::string_view>, sizeof...(T)>{envname_of<T>()...});
+
+    constexpr auto env_flag_value(std::string_view value) noexcept -> std::optional<bool> {
+        for (auto v : {"1", "true", "yes", "on", "TRUE", "YES", "ON"})
+            if (value == v)
+                return true;
+        for (auto v : {"", "0", "false", "no", "off", "FALSE", "NO", "OFF"})
+            if (value == v)
+                return false;
+        return std::nullopt;
+    }
+    /// Sets `argument` from its environment variable `value` if the command line left it unset.
+    template <class Argument>
+    constexpr auto apply_env_value([[maybe_unused]] Argument& argument, std::optional<std::string_view> value) -> Expected<void> {
+        if constexpr (!HasEnvName<Argument>)
+            return {};
+        if (!value)
+            return {};
+        Expected<void> res;
+        if constexpr (model::IsArgumentTyped<Argument, model::ArgumentType::Flag>) {
+            if (argument.occurences > 0)
+                return {};
+            auto flag = env_flag_value(*value);
+            if (!flag) [[unlikely]] {
+                res = make_unexpected(Error{
+                    .parameter = std::string_view(),
+                    .value = value,
+                    .type = Error::Type::Flag,
+                    .code = Error::Code::BadValidation
+                });
+            } else if (*flag) {
+                res = glap::parser<Argument>.parse(argument);
+            }
+        } else if constexpr (model::IsArgumentTyped<Argument, model::ArgumentType::Parameter>) {
+            if constexpr (requires { argument.values; }) {
+                if (argument.values.size() > 0)
+                    return {};
+            } else {
+                if (argument.value)
+                    return {};
+            }
+            res = glap::parser<Argument>.parse(argument, *value);
+        }
+        if (!res) [[unlikely]] {
+            auto error = res.error();
+            error.parameter = envname_of<Argument>().value_or(std::string_view());
+            error.type = Error::Type::Environment;
+            return make_unexpected(error);
+        }
+        return res;
+    }
+}
+
+GLAP_EXPORT namespace glap
+{
+    /// Sets the flags and parameters left unset by the command line from their environment variable (see `Env`).
+    /// The environment is read in a single pass. Values are resolved and validated like command line values, errors
+    /// have the type `Error::Type::Environment`. Parameter values are views into `envp`.
+    template <class CommandNames, class... Arguments>
+    constexpr auto apply_environment(model::Command<CommandNames, Arguments...>& command, const char* const* envp = impl::environment()) -> Expected<void>
+    {
+        if constexpr ((HasEnvName<Arguments> || ...)) {
+            std::array<std::optional<std::string_view>, sizeof...(Arguments)> values = {};
+            for (auto env = envp; env && *env; ++env) {
+                auto entry = std::string_view(*env);
+                auto pos_equal = entry.find('=');
+                if (pos_equal == std::string_view::npos)
+                    continue;
+                auto index = impl::envname_table<Arguments...>.find(entry.substr(0, pos_equal));
+                if (index != impl::npos_index && !values[index])
+                    values[index] = entry.substr(pos_equal + 1);
+            }
+            Expected<void> result;
+            [&]<size_t ...I>(std::index_sequence<I...>) {
+                (void)((result = impl::apply_env_value(std::get<I>(command.arguments), values[I])) && ...);
+            }(std::index_sequence_for<Arguments...>{});
+            return result;
+        } else {
+            return {};
+        }
+    }
+    /// Same as above, on the selected command of `program`.
+    template <StringLiteral Name, model::DefaultCommand def_cmd, class... Commands>
+    constexpr auto apply_environment(model::Program<Name, def_cmd, Commands...>& program, const char* const* envp = impl::environment()) -> Expected<void>
+    {
+        return std::visit([envp](auto& command) {
+            return apply_environment(command, envp);
+        }, program.command);
+    }
+}
\ No newline at end of file
@@ -2,4 +2,11 @@
 
 #include "parser.h"
 #include "model.h"
-// #include "help.h"
\ No newline at end of file
+#include "incremental.h"
+#include "mapped.h"
+#include "environment.h"
+#include "config.h"
+#include "batch.h"
+#include "help.h"
+#include "completion.h"
+#include "serialize.h"
\ No newline at end of file
@@ -51,6 +51,9 @@ GLAP_EXPORT namespace glap {
 
     template<class FromHelp, class FromParser>
     inline constexpr auto get_help = Help<FromHelp, FromParser>{};
+    /// Help text rendered at compile time, stored in read only data
+    template<class FromHelp, class FromParser>
+    inline constexpr std::string_view help_text = Help<FromHelp, FromParser>::text();
 }
 
 #ifndef GLAP_MODULE
@@ -0,0 +1,521 @@
+#pragma once
+
+#ifndef GLAP_MODULE
+#include "../core/utf8.h"
+#include "../core/utils.h"
+#include "../completion.h"
+#include "../help.h"
+#include "../model.h"
+#include "help.inl"
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tuple>
+#endif
+
+namespace glap {
+    namespace impl {
+        template <class ProgramHelp, class CommandParser>
+        struct CommandHelpOf {
+            using type = void;
+        };
+        template <StringLiteral Name, help::IsDescription Desc, class ...CommandsHelp, class CommandParser>
+        struct CommandHelpOf<help::model::Program<Name, Desc, CommandsHelp...>, CommandParser> {
+            using type = typename FindByName<CommandParser, CommandsHelp...>::type;
+        };
+        template <class CommandHelp, class ArgumentParser>
+        struct ArgumentHelpOf {
+            using type = void;
+        };
+        template <StringLiteral Name, help::IsDescription Desc, class ...ParamsHelp, class ArgumentParser>
+        struct ArgumentHelpOf<help::model::Command<Name, Desc, ParamsHelp...>, ArgumentParser> {
+            using type = typename FindByName<ArgumentParser, ParamsHelp...>::type;
+        };
+        template <class FromHelp>
+        constexpr auto short_description_of() noexcept -> std::string_view {
+            if constexpr (help::IsDescription<FromHelp>)
+                return FromHelp::short_description;
+            else
+                return {};
+        }
+        /// Arguments which can be given several times
+        template <class Argument>
+        struct IsRepeatable : std::false_type
+        {};
+        template <class ArgNames>
+        struct IsRepeatable<model::Flag<ArgNames>> : std::true_type
+        {};
+        template <class ArgNames, auto N, auto Resolver, auto Validator>
+        struct IsRepeatable<model::Parameters<ArgNames, N, Resolver, Validator>> : std::true_type
+        {};
+        template <auto N, auto Resolver, auto Validator>
+        struct IsRepeatable<model::Inputs<N, Resolver, Validator>> : std::true_type
+        {};
+
+        /// Writes `str` inside a single quoted string: quotes are replaced by `quote`, characters of `escaped` are
+        /// prefixed by a backslash and new lines are replaced by spaces
+        template <class Writer>
+        constexpr void write_quoted(Writer& out, std::string_view str, std::string_view quote, std::string_view escaped = {}) {
+            for (size_t i = 0; i < str.size(); ++i) {
+                if (str[i] == '\'') {
+                    out.write(quote);
+                } else if (str[i] == '\n') {
+                    out.write(" ");
+                } else {
+                    if (escaped.find(str[i]) != std::string_view::npos)
+                        out.write("\\");
+                    out.write(str.substr(i, 1));
+                }
+            }
+        }
+        /// Writes `name` as a shell function name
+        template <class Writer>
+        constexpr void write_identifier(Writer& out, std::string_view name) {
+            for (size_t i = 0; i < name.size(); ++i) {
+                auto c = name[i];
+                auto valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+                out.write(valid ? name.substr(i, 1) : "_");
+            }
+        }
+        template <class Names, class Writer>
+        constexpr void write_shortname(Writer& out, std::string_view prefix) {
+            out.write(prefix);
+            write_codepoint(out, Names::shortname.value());
+        }
+        /// Writes the names selecting `Names`, separated by `separator`
+        template <class Names, class Writer>
+        constexpr void write_names(Writer& out, std::string_view long_prefix, std::string_view short_prefix, std::string_view separator) {
+            out.write(long_prefix);
+            out.write(Names::longname);
+            if constexpr (HasShortName<Names>) {
+                out.write(separator);
+                write_shortname<Names>(out, short_prefix);
+            }
+        }
+
+        template <class CommandHelp, class CommandParser>
+        struct CommandCompletion
+        {};
+        template <class CommandHelp, class CommandNames, class ...Arguments>
+        struct CommandCompletion<CommandHelp, model::Command<CommandNames, Arguments...>>
+        {
+            using CommandParser = model::Command<CommandNames, Arguments...>;
+            static constexpr bool has_parameters = (model::IsArgumentTyped<Arguments, model::ArgumentType::Parameter> || ...);
+            static constexpr bool has_short_parameters = ((model::IsArgumentTyped<Arguments, model::ArgumentType::Parameter> && HasShortName<Arguments>) || ...);
+            static constexpr bool has_inputs = (model::IsArgumentTyped<Arguments, model::ArgumentType::Input> || ...);
+
+            static constexpr auto description() noexcept -> std::string_view {
+                return short_description_of<CommandHelp>();
+            }
+            /// Body of the bash completion of the command arguments, from `$cur` and `$prev`.
+            /// Long parameters only take their value after `=` (`--param=VALUE`), short ones in the next word.
+            template <class Writer>
+            static constexpr void bash(Writer& out, size_t indent) {
+                if constexpr (has_short_parameters) {
+                    out.pad(indent);
+                    out.write("case $prev in\n");
+                    out.pad(indent + 4);
+                    auto first = true;
+                    ([&] {
+                        if constexpr (model::IsArgumentTyped<Arguments, model::ArgumentType::Parameter> && HasShortName<Arguments>) {
+                            if (!first)
+                                out.write("|");
+                            first = false;
+                            write_shortname<Arguments>(out, "-");
+                        }
+                    }(), ...);
+                    out.write(")\n");
+                    out.pad(indent + 8);
+                    out.write("compopt -o default\n");
+                    out.pad(indent + 8);
+                    out.write("return;;\n");
+                    out.pad(indent);
+                    out.write("esac\n");
+                }
+                if constexpr (has_parameters) {
+                    // `=` is usually a word break: `--param=` ends with the word `=`, `--param=v` with `=` and `v`
+                    out.pad(indent);
+                    out.write("local word=$cur\n");
+                    out.pad(indent);
+                    out.write("if [[ $cur == = ]]; then\n");
+                    out.pad(indent + 4);
+                    out.write("word=$prev=\n");
+                    out.pad(indent);
+                    out.write("elif [[ $prev == = ]]; then\n");
+                    out.pad(indent + 4);
+                    out.write("word=${COMP_WORDS[COMP_CWORD-2]}=$cur\n");
+                    out.pad(indent);
+                    out.write("fi\n");
+                    out.pad(indent);
+                    out.write("case $word in\n");
+                    out.pad(indent + 4);
+                    auto first = true;
+                    ([&] {
+                        if constexpr (model::IsArgumentTyped<Arguments, model::ArgumentType::Parameter>) {
+                            if (!first)
+                                out.write("|");
+                            first = false;
+                            out.write("--");
+                            out.write(Arguments::longname);
+                            out.write("=*");
+                        }
+                    }(), ...);
+                    out.write(")\n");
+                    out.pad(indent + 8);
+                    out.write("compopt -o filenames\n");
+                    out.pad(indent + 8);
+                    out.write("COMPREPLY=($(compgen -f -- \"${word#*=}\"))\n");
+                    out.pad(indent + 8);
+                    out.write("[[ $COMP_WORDBREAKS == *=* ]] || COMPREPLY=(\"${COMPREPLY[@]/#/${word%%=*}=}\")\n");
+                    out.pad(indent + 8);
+                    out.write("return;;\n");
+                    out.pad(indent);
+                    out.write("esac\n");
+                }
+                if constexpr (has_inputs) {
+                    out.pad(indent);
+                    out.write("if [[ $cur != -* ]]; then\n");
+                    out.pad(indent + 4);
+                    out.write("compopt -o default\n");
+                    out.pad(indent + 4);
+                    out.write("return\n");
+                    out.pad(indent);
+                    out.write("fi\n");
+                }
+                out.pad(indent);
+                out.write("COMPREPLY=($(compgen -W '");
+                auto first = true;
+                ([&] {
+                    if constexpr (HasNames<Arguments>) {
+                        if (!first)
+                            out.write(" ");
+                        first = false;
+                        out.write("--");
+                        out.write(Arguments::longname);
+                        if constexpr (model::IsArgumentTyped<Arguments, model::ArgumentType::Parameter>)
+                            out.write("=");
+                        if constexpr (HasShortName<Arguments>)
+                            write_shortname<Arguments>(out, " -");
+                    }
+                }(), ...);
+                out.write("' -- \"$cur\"))\n");
+                if constexpr (has_parameters) {
+                    out.pad(indent);
+                    out.write("[[ $COMPREPLY == *= ]] && compopt -o nospace\n");
+                }
+            }
+            /// `_arguments` call completing the command arguments
+            template <class Writer>
+            static constexpr void zsh(Writer& out) {
+                out.write("    _arguments");
+                ([&] {
+                    constexpr auto arg_description = short_description_of<typename ArgumentHelpOf<CommandHelp, Arguments>::type>();
+                    auto option = [&](auto write_name, std::string_view value_spec) {
+                        out.write(" \\\n        '");
+                        if constexpr (IsRepeatable<Arguments>::value) {
+                            out.write("*");
+                        } else {
+                            out.write("(");
+                            write_names<Arguments>(out, "--", "-", " ");
+                            out.write(")");
+                        }
+                        write_name();
+                        if constexpr (!arg_description.empty()) {
+                            out.write("[");
+                            write_quoted(out, arg_description, "'\\''", "\\[]");
+                            out.write("]");
+                        }
+                        out.write(value_spec);
+                        out.write("'");
+                    };
+                    if constexpr (model::IsArgumentTyped<Arguments, model::ArgumentType::Input>) {
+                        out.write(" \\\n        '");
+                        if constexpr (IsRepeatable<Arguments>::value)
+                            out.write("*");
+                        out.write(":input:_files'");
+                    } else {
+                        constexpr auto is_parameter = model::IsArgumentTyped<Arguments, model::ArgumentType::Parameter>;
+                        // `--param=-`: the value of a long parameter is in the same word, after `=`
+                        option([&] {
+                            out.write("--");
+                            out.write(Arguments::longname);
+                            if constexpr (is_parameter)
+                                out.write("=-");
+                        }, is_parameter ? ":value:_default" : "");
+                        if constexpr (HasShortName<Arguments>)
+                            option([&] { write_shortname<Arguments>(out, "-"); }, is_parameter ? ":value:_default" : "");
+                    }
+                }(), ...);
+                out.write("\n");
+            }
+            /// `complete` calls of the command arguments, each one starting with `prefix`.
+            /// fish offers the value of a long parameter both after `=` and in the next word; glap only takes the first.
+            template <class Writer>
+            static constexpr void fish(Writer& out, auto&& prefix) {
+                ([&] {
+                    constexpr auto arg_description = short_description_of<typename ArgumentHelpOf<CommandHelp, Arguments>::type>();
+                    prefix();
+                    if constexpr (model::IsArgumentTyped<Arguments, model::ArgumentType::Input>) {
+                        out.write(" -F\n");
+                    } else {
+                        if constexpr (HasShortName<Arguments>)
+                            write_shortname<Arguments>(out, " -s ");
+                        out.write(" -l ");
+                        out.write(Arguments::longname);
+                        if constexpr (model::IsArgumentTyped<Arguments, model::ArgumentType::Parameter>)
+                            out.write(" -r");
+                        if constexpr (!arg_description.empty()) {
+                            out.write(" -d '");
+                            write_quoted(out, arg_description, "\\'", "\\");
+                            out.write("'");
+                        }
+                        out.write("\n");
+                    }
+                }(), ...);
+            }
+        };
+    }
+
+    template<class Shell, class FromHelp, StringLiteral Name, model::DefaultCommand def_cmd, class ...Commands>
+    struct Completion<Shell, FromHelp, model::Program<Name, def_cmd, Commands...>> {
+        using ProgramParser = model::Program<Name, def_cmd, Commands...>;
+
+        /// Completion script, rendered at compile time
+        [[nodiscard]] static constexpr std::string_view text() noexcept {
+            return std::string_view(impl::static_help<Completion>.data(), impl::static_help<Completion>.size());
+        }
+        [[nodiscard]] constexpr std::string operator()() const noexcept {
+            return std::string(text());
+        }
+        template <class OutputIt>
+        constexpr OutputIt operator()(OutputIt it) const noexcept {
+            return std::copy(text().begin(), text().end(), it);
+        }
+        template <class Writer>
+        constexpr void render(Writer& out) const {
+            if constexpr (std::same_as<Shell, completion::Bash>)
+                bash(out);
+            else if constexpr (std::same_as<Shell, completion::Zsh>)
+                zsh(out);
+            else if constexpr (std::same_as<Shell, completion::Fish>)
+                fish(out);
+            else
+                static_assert(impl::always_false_v<Shell>, "unknown shell");
+        }
+    private:
+        template <class Command>
+        using command_completion = impl::CommandCompletion<typename impl::CommandHelpOf<FromHelp, Command>::type, Command>;
+        template <class Command>
+        static constexpr bool is_default = def_cmd == model::DefaultCommand::FirstDefined
+            && std::same_as<Command, std::tuple_element_t<0, std::tuple<Commands...>>>;
+
+        template <class Writer>
+        static constexpr void function_name(Writer& out) {
+            out.write("_");
+            impl::write_identifier(out, ProgramParser::name);
+        }
+        template <class Writer>
+        static constexpr void bash(Writer& out) {
+            function_name(out);
+            out.write("() {\n"
+                "    local cur=${COMP_WORDS[COMP_CWORD]} prev=${COMP_WORDS[COMP_CWORD-1]}\n"
+                "    if (( COMP_CWORD == 1 )) && [[ $cur != -* ]]; then\n"
+                "        COMPREPLY=($(compgen -W '");
+            auto first = true;
+            ([&] {
+                if (!first)
+                    out.write(" ");
+                first = false;
+                out.write(Commands::longname);
+            }(), ...);
+            out.write("' -- \"$cur\"))\n"
+                "        return\n"
+                "    fi\n"
+                "    case ${COMP_WORDS[1]} in\n");
+            ([&] {
+                out.pad(8);
+                impl::write_names<Commands>(out, "", "", "|");
+                if constexpr (is_default<Commands>)
+                    out.write("|-*");
+                out.write(")\n");
+                command_completion<Commands>::bash(out, 12);
+                out.pad(12);
+                out.write(";;\n");
+            }(), ...);
+            out.write("    esac\n"
+                "}\n"
+                "complete -F ");
+            function_name(out);
+            out.write(" ");
+            out.write(ProgramParser::name);
+            out.write("\n");
+        }
+        template <class Writer>
+        static constexpr void zsh(Writer& out) {
+            out.write("#compdef ");
+            out.write(ProgramParser::name);
+            out.write("\n");
+            ([&] {
+                out.write("\n");
+                function_name(out);
+                out.write("_");
+                impl::write_identifier(out, Commands::longname);
+                out.write("() {\n");
+                command_completion<Commands>::zsh(out);
+                out.write("}\n");
+            }(), ...);
+            out.write("\n");
+            function_name(out);
+            out.write("() {\n"
+                "    local -a commands=(");
+            ([&] {
+                out.write("\n        '");
+                impl::write_quoted(out, Commands::longname, "'\\''", ":");
+                if constexpr (constexpr auto description = command_completion<Commands>::description(); !description.empty()) {
+                    out.write(":");
+                    impl::write_quoted(out, description, "'\\''");
+                }
+                out.write("'");
+            }(), ...);
+            out.write("\n    )\n"
+                "    if (( CURRENT == 2 )) && [[ $PREFIX != -* ]]; then\n"
+                "        _describe command commands\n"
+                "        return\n"
+                "    fi\n"
+                "    case $words[2] in\n");
+            ([&] {
+                out.write("        (");
+                impl::write_names<Commands>(out, "", "", "|");
+                out.write(")\n"
+                    "            shift words\n"
+                    "            (( CURRENT-- ))\n"
+                    "            ");
+                function_name(out);
+                out.write("_");
+                impl::write_identifier(out, Commands::longname);
+                out.write(";;\n");
+                if constexpr (is_default<Commands>) {
+                    out.write("        (-*)\n            ");
+                    function_name(out);
+                    out.write("_");
+                    impl::write_identifier(out, Commands::longname);
+                    out.write(";;\n");
+                }
+            }(), ...);
+            out.write("    esac\n"
+                "}\n\n"
+                "if [ \"$funcstack[1]\" = \"");
+            function_name(out);
+            out.write("\" ]; then\n    ");
+            function_name(out);
+            out.write(" \"$@\"\nelse\n    compdef ");
+            function_name(out);
+            out.write(" ");
+            out.write(ProgramParser::name);
+            out.write("\nfi\n");
+        }
+        template <class Writer>
+        static constexpr void fish(Writer& out) {
+            auto complete = [&] {
+                out.write("complete -c ");
+                out.write(ProgramParser::name);
+            };
+            complete();
+            out.write(" -f\n");
+            ([&] {
+                complete();
+                out.write(" -n __fish_use_subcommand -a ");
+                out.write(Commands::longname);
+                if constexpr (constexpr auto description = command_completion<Commands>::description(); !description.empty()) {
+                    out.write(" -d '");
+                    impl::write_quoted(out, description, "\\'", "\\");
+                    out.write("'");
+                }
+                out.write("\n");
+            }(), ...);
+            ([&] {
+                if constexpr (is_default<Commands>) {
+                    command_completion<Commands>::fish(out, [&] {
+                        complete();
+                        out.write(" -n __fish_use_subcommand");
+                    });
+                }
+                command_completion<Commands>::fish(out, [&] {
+                    complete();
+                    out.write(" -n '__fish_seen_subcommand_from ");
+                    impl::write_names<Commands>(out, "", "", " ");
+                    out.write("'");
+                });
+            }(), ...);
+        }
+    };
+
+    template<class Shell, class FromHelp, class CommandNames, model::IsArgument ...Arguments>
+    struct Completion<Shell, FromHelp, model::Command<CommandNames, Arguments...>> {
+        using CommandParser = model::Command<CommandNames, Arguments...>;
+
+        /// Completion script, rendered at compile time
+        [[nodiscard]] static constexpr std::string_view text() noexcept {
+            return std::string_view(impl::static_help<Completion>.data(), impl::static_help<Completion>.size());
+        }
+        [[nodiscard]] constexpr std::string operator()() const noexcept {
+            return std::string(text());
+        }
+        template <class OutputIt>
+        constexpr OutputIt operator()(OutputIt it) const noexcept {
+            return std::copy(text().begin(), text().end(), it);
+        }
+        template <class Writer>
+        constexpr void render(Writer& out) const {
+            if constexpr (std::same_as<Shell, completion::Bash>) {
+                function_name(out);
+                out.write("() {\n"
+                    "    local cur=${COMP_WORDS[COMP_CWORD]} prev=${COMP_WORDS[COMP_CWORD-1]}\n");
+                command_completion::bash(out, 4);
+                out.write("}\n"
+                    "complete -F ");
+                function_name(out);
+                out.write(" ");
+                out.write(CommandParser::longname);
+                out.write("\n");
+            } else if constexpr (std::same_as<Shell, completion::Zsh>) {
+                out.write("#compdef ");
+                out.write(CommandParser::longname);
+                out.write("\n\n");
+                function_name(out);
+                out.write("() {\n");
+                command_completion::zsh(out);
+                out.write("}\n\n"
+                    "if [ \"$funcstack[1]\" = \"");
+                function_name(out);
+                out.write("\" ]; then\n    ");
+                function_name(out);
+                out.write(" \"$@\"\nelse\n    compdef ");
+                function_name(out);
+                out.write(" ");
+                out.write(CommandParser::longname);
+                out.write("\nfi\n");
+            } else if constexpr (std::same_as<Shell, completion::Fish>) {
+                auto complete = [&] {
+                    out.write("complete -c ");
+                    out.write(CommandParser::longname);
+                };
+                complete();
+                out.write(" -f\n");
+                command_completion::fish(out, complete);
+            } else {
+                static_assert(impl::always_false_v<Shell>, "unknown shell");
+            }
+        }
+    private:
+        using command_completion = impl::CommandCompletion<FromHelp, CommandParser>;
+
+        template <class Writer>
+        static constexpr void function_name(Writer& out) {
+            out.write("_");
+            impl::write_identifier(out, CommandParser::longname);
+        }
+    };
+}
\ No newline at end of file
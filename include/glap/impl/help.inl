@@ -1,21 +1,24 @@
 #pragma once
 
 #ifndef GLAP_MODULE
-#include "core/utf8.h"
-#include "core/discard.h"
-#include "core/utils.h"
-#include "help.h"
+#include "../core/utf8.h"
+#include "../core/discard.h"
+#include "../core/utils.h"
+#include "../help.h"
 
-#include "model.h"
-#include "parser.h"
+#include "../model.h"
+#include "../parser.h"
 #include <cstddef>
 #include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
 #endif
 
 namespace glap {
     namespace impl {
         template <class P, class H>
-        concept IsHelpInputsCompatible = requires { P::type == glap::model::ArgumentType::Input; } && help::IsInputs<H>;
+        concept IsHelpInputsCompatible = glap::model::IsArgumentTyped<P, glap::model::ArgumentType::Input> && help::IsInputs<H>;
         template <class FromParser, class ...Others>
         struct FindByName
         {};
@@ -56,7 +59,54 @@ namespace glap {
             return max;
         }
         template <class>
-        static constexpr bool always_false_v = false;
+        inline constexpr bool always_false_v = false;
+
+        /// Help renderers write through a writer: the same rendering counts the characters, then writes them.
+        struct CountWriter {
+            size_t size = 0;
+            constexpr void write(std::string_view str) noexcept {
+                size += str.size();
+            }
+            constexpr void pad(size_t count) noexcept {
+                size += count;
+            }
+        };
+        template <class OutputIt>
+        struct IteratorWriter {
+            OutputIt it;
+            constexpr void write(std::string_view str) {
+                it = std::copy(str.begin(), str.end(), it);
+            }
+            constexpr void pad(size_t count) {
+                it = std::fill_n(it, count, ' ');
+            }
+        };
+        template <class Writer>
+        constexpr void write_codepoint(Writer& out, char32_t codepoint) {
+            char utf8[4] = {};
+            out.write(std::string_view(utf8, glap::utils::uni::codepoint_to_utf8(codepoint, utf8)));
+        }
+        template <class FromHelp, class Writer>
+        constexpr void write_description(Writer& out) {
+            out.write(FromHelp::short_description);
+            if constexpr(help::IsFullDescription<FromHelp>) {
+                out.write("\n\n");
+                out.write(FromHelp::long_description);
+            }
+        }
+        /// Help text of `HelpType` rendered at compile time, exactly sized
+        template <class HelpType>
+        inline constexpr auto static_help = [] {
+            constexpr auto size = [] {
+                auto out = CountWriter{};
+                HelpType{}.render(out);
+                return out.size;
+            }();
+            std::array<char, size> text = {};
+            auto out = IteratorWriter<char*>{text.data()};
+            HelpType{}.render(out);
+            return text;
+        }();
         template<class T, class>
         struct BasicHelp
         {
@@ -66,98 +116,131 @@ namespace glap {
             requires help::IsInputs<FromHelp>
         struct BasicHelp<FromHelp, InputParser>
         {
-            template <class OutputIt, bool Fullname = false>
-            OutputIt name(OutputIt it) const noexcept {
-                return glap::format_to(it, "INPUTS");
-            }
-            template <class OutputIt, bool FullDescription = false>
-            OutputIt description(OutputIt it) const noexcept {
-                if constexpr(help::IsFullDescription<FromHelp>)
-                    return glap::format_to(it, "{}\n\n{}", FromHelp::short_description, FromHelp::long_description);
-                else
-                    return glap::format_to(it, "{}", FromHelp::short_description);
-            }
-            template <class OutputIt, bool FullName = false, bool FullDescription = false>
-            OutputIt identity(OutputIt it) const noexcept {
-                it = name<OutputIt, FullName>(it);
-                it = glap::format_to(it, " - ");
-                it = description<OutputIt, FullDescription>(it);
-                return it;
+            template <bool FullName = false>
+            constexpr void name(auto& out) const {
+                out.write(help::INPUTS_NAME);
+            }
+            template <bool FullDescription = false>
+            constexpr void description(auto& out) const {
+                write_description<FromHelp>(out);
+            }
+            template <bool FullName = false, bool FullDescription = false>
+            constexpr void identity(auto& out) const {
+                name<FullName>(out);
+                out.write(" - ");
+                description<FullDescription>(out);
             }
         };
         template<help::IsDescription FromHelp, HasLongName FromParser>
         struct BasicHelp<FromHelp, FromParser>
         {
-            template <class OutputIt, bool Fullname = false>
-            OutputIt name(OutputIt it) const noexcept {
-                if constexpr(Fullname && HasShortName<FromParser>)
-                    return glap::format_to(it, "{}, {}", glap::utils::uni::codepoint_to_utf8(FromParser::shortname.value()), FromParser::longname);
-                else
-                    return glap::format_to(it, "{}", FromParser::longname);
-            }
-            template <class OutputIt, bool FullDescription = false>
-            OutputIt description(OutputIt it) const noexcept {
-                if constexpr(help::IsFullDescription<FromHelp>)
-                    return glap::format_to(it, "{}\n\n{}", FromHelp::short_description, FromHelp::long_description);
-                else
-                    return glap::format_to(it, "{}", FromHelp::short_description);
-            }
-            template <class OutputIt, bool FullName = false, bool FullDescription = false>
-            OutputIt identity(OutputIt it) const noexcept {
-                it = name<OutputIt, FullName>(it);
-                it = glap::format_to(it, " - ");
-                it = description<OutputIt, FullDescription>(it);
-                return it;
+            template <bool FullName = false>
+            constexpr void name(auto& out) const {
+                if constexpr(FullName && HasShortName<FromParser>) {
+                    write_codepoint(out, FromParser::shortname.value());
+                    out.write(", ");
+                }
+                out.write(FromParser::longname);
+            }
+            template <bool FullDescription = false>
+            constexpr void description(auto& out) const {
+                write_description<FromHelp>(out);
+            }
+            template <bool FullName = false, bool FullDescription = false>
+            constexpr void identity(auto& out) const {
+                name<FullName>(out);
+                out.write(" - ");
+                description<FullDescription>(out);
+            }
+        };
+        template<help::IsDescription FromHelp, StringLiteral Name, glap::model::DefaultCommand def_cmd, class ...Commands>
+        struct BasicHelp<FromHelp, glap::model::Program<Name, def_cmd, Commands...>>
+        {
+            template <bool FullName = false>
+            constexpr void name(auto& out) const {
+                out.write(glap::model::Program<Name, def_cmd, Commands...>::name);
+            }
+            template <bool FullDescription = false>
+            constexpr void description(auto& out) const {
+                write_description<FromHelp>(out);
+            }
+            template <bool FullName = false, bool FullDescription = false>
+            constexpr void identity(auto& out) const {
+                name<FullName>(out);
+                out.write(" - ");
+                description<FullDescription>(out);
             }
         };
         template<HasNames FromParser>
         struct BasicHelp<void, FromParser>
         {
-            template <class OutputIt, bool Fullname = false>
-            OutputIt name(OutputIt it) const noexcept {
-                if constexpr(Fullname && HasNames<FromParser> && FromParser::shortname.has_value())
-                    return glap::format_to(it, "{}, {}", glap::utils::uni::codepoint_to_utf8(FromParser::shortname.value()), FromParser::longname);
-                else
-                    return glap::format_to(it, "{}", FromParser::longname);
-            }
-            template <class OutputIt, bool FullDescription = false>
-            OutputIt description(OutputIt it) const noexcept {
-                return glap::format_to(it, "(no description)");
-            }
-            template <class OutputIt, bool FullName = false, bool FullDescription = false>
-            OutputIt identity(OutputIt it) const noexcept {
-                it = name<OutputIt, FullName>(it);
-                it = glap::format_to(it, " - (no description)");
-                return it;
+            template <bool FullName = false>
+            constexpr void name(auto& out) const {
+                if constexpr(FullName && HasShortName<FromParser>) {
+                    write_codepoint(out, FromParser::shortname.value());
+                    out.write(", ");
+                }
+                out.write(FromParser::longname);
+            }
+            template <bool FullDescription = false>
+            constexpr void description(auto& out) const {
+                out.write("(no description)");
+            }
+            template <bool FullName = false, bool FullDescription = false>
+            constexpr void identity(auto& out) const {
+                name<FullName>(out);
+                out.write(" - (no description)");
+            }
+        };
+        template<glap::model::IsArgumentTyped<glap::model::ArgumentType::Input> InputParser>
+        struct BasicHelp<void, InputParser>
+        {
+            template <bool FullName = false>
+            constexpr void name(auto& out) const {
+                out.write(help::INPUTS_NAME);
+            }
+            template <bool FullDescription = false>
+            constexpr void description(auto& out) const {
+                out.write("(no description)");
+            }
+            template <bool FullName = false, bool FullDescription = false>
+            constexpr void identity(auto& out) const {
+                name<FullName>(out);
+                out.write(" - (no description)");
             }
         };
         template<class FromHelp, class FromParser>
-        static constexpr auto basic_help = BasicHelp<FromHelp, FromParser>{};
+        inline constexpr auto basic_help = BasicHelp<FromHelp, FromParser>{};
     }
 
-    template<StringLiteral NameHelp, help::IsDescription Desc, class ...CommandsHelp, StringLiteral NameParser, DefaultCommand def_cmd, class... CommandsParser>
-    struct Help<help::model::Program<NameHelp, Desc, CommandsHelp...>, Parser<NameParser, def_cmd, CommandsParser...>> {
+    template<StringLiteral NameHelp, help::IsDescription Desc, class ...CommandsHelp, StringLiteral NameParser, model::DefaultCommand def_cmd, class... CommandsParser>
+    struct Help<help::model::Program<NameHelp, Desc, CommandsHelp...>, model::Program<NameParser, def_cmd, CommandsParser...>> {
         using ProgramHelp = help::model::Program<NameHelp, Desc, CommandsHelp...>;
-        using ProgramParser = Parser<NameParser, def_cmd, CommandsParser...>;
+        using ProgramParser = model::Program<NameParser, def_cmd, CommandsParser...>;
 
+        /// Help text, rendered at compile time
+        [[nodiscard]] static constexpr std::string_view text() noexcept {
+            return std::string_view(impl::static_help<Help>.data(), impl::static_help<Help>.size());
+        }
         [[nodiscard]] constexpr std::string operator()() const noexcept {
-            std::string result;
-            this->operator()(std::back_inserter(result));
-            return result;
+            return std::string(text());
         }
         template <class OutputIt>
         constexpr OutputIt operator()(OutputIt it) const noexcept {
-            it = this_basic_help.template identity<OutputIt, false, false>(it);
-            it = glap::format_to(it, "\n\n");
-            it = glap::format_to(it, "Command{}:\n", sizeof...(CommandsParser) > 1 ? "s" : "");
-            // constexpr auto max_cmd_name_length = impl::max_length<CommandsParser...>(2)+2;
+            return std::copy(text().begin(), text().end(), it);
+        }
+        template <class Writer>
+        constexpr void render(Writer& out) const {
+            this_basic_help.template identity<false, false>(out);
+            out.write("\n\n");
+            out.write(sizeof...(CommandsParser) > 1 ? "Commands:\n" : "Command:\n");
             ([&] {
                 constexpr auto cmd_basic_help = impl::basic_help<typename impl::FindByName<CommandsParser, CommandsHelp...>::type, CommandsParser>;
                 constexpr auto spacing = cmd_name_max_length - impl::max_length<CommandsParser>(2);
-                it = glap::format_to(it, "\n{0:>{1}}", "", spacing);
-                it = cmd_basic_help.template identity<OutputIt, true, false>(it);
+                out.write("\n");
+                out.pad(spacing);
+                cmd_basic_help.template identity<true, false>(out);
             }(), ...);
-            return it;
         }
     private:
         static constexpr auto cmd_name_max_length = impl::max_length<CommandsParser...>(2)+help::PADDING;
@@ -168,42 +251,55 @@ namespace glap {
     struct Help<help::model::Command<Name, Desc, ParamsHelp...>, model::Command<CommandNames, ParamsParser...>> {
         using CommandHelp = help::model::Command<Name, Desc, ParamsHelp...>;
         using CommandParser = model::Command<CommandNames, ParamsParser...>;
+        /// Help text, rendered at compile time
+        [[nodiscard]] static constexpr std::string_view text() noexcept {
+            return std::string_view(impl::static_help<Help>.data(), impl::static_help<Help>.size());
+        }
         [[nodiscard]] constexpr std::string operator()() const noexcept {
-            std::string result;
-            this->operator()(std::back_inserter(result));
-            return result;
+            return std::string(text());
         }
         template <class OutputIt, bool DisplayUsage = true>
         constexpr OutputIt operator()(OutputIt it) const noexcept {
-            it = this_basic_help.template identity<OutputIt, false, false>(it);
-            it = glap::format_to(it, "\n\n");
             if constexpr(DisplayUsage) {
-                it = glap::format_to(it, "Usage:\n{0:>{1}}" , "", help::PADDING);
-                it = this_basic_help.name(it);
+                return std::copy(text().begin(), text().end(), it);
+            } else {
+                auto out = impl::IteratorWriter<OutputIt>{it};
+                render<false>(out);
+                return out.it;
+            }
+        }
+        template <bool DisplayUsage = true, class Writer>
+        constexpr void render(Writer& out) const {
+            this_basic_help.template identity<false, false>(out);
+            out.write("\n\n");
+            if constexpr(DisplayUsage) {
+                out.write("Usage:\n");
+                out.pad(help::PADDING);
+                this_basic_help.name(out);
                 ([&] {
                     constexpr auto param_basic_help = impl::basic_help<typename impl::FindByName<ParamsParser, ParamsHelp...>::type, ParamsParser>;
                     if constexpr(model::IsArgumentTyped<ParamsParser, model::ArgumentType::Parameter>) {
-                        it = glap::format_to(it, " [--");
-                        it = param_basic_help.template name<OutputIt>(it);
-                        it = glap::format_to(it, " VALUE]");
+                        out.write(" [--");
+                        param_basic_help.name(out);
+                        out.write(" VALUE]");
                     } else if constexpr(model::IsArgumentTyped<ParamsParser, model::ArgumentType::Flag>) {
-                        it = glap::format_to(it, " [--");
-                        it = param_basic_help.template name<OutputIt>(it);
-                        it = glap::format_to(it, "]");
+                        out.write(" [--");
+                        param_basic_help.name(out);
+                        out.write("]");
                     } else if constexpr(model::IsArgumentTyped<ParamsParser, model::ArgumentType::Input>) {
-                        it = glap::format_to(it, " <INPUTS>");
+                        out.write(" <INPUTS>");
                     }
                 }(), ...);
-                it = glap::format_to(it, "\n\n");
+                out.write("\n\n");
             }
-            it = glap::format_to(it, "Argument{}:\n", sizeof...(ParamsParser) > 1 ? "s" : "");
+            out.write(sizeof...(ParamsParser) > 1 ? "Arguments:\n" : "Argument:\n");
             ([&] {
                 constexpr auto param_basic_help = impl::basic_help<typename impl::FindByName<ParamsParser, ParamsHelp...>::type, ParamsParser>;
                 constexpr auto spacing = param_name_max_length - impl::max_length<ParamsParser>(2);
-                it = glap::format_to(it, "\n{0:>{1}}", "", spacing);
-                it = param_basic_help.template identity<OutputIt, true, false>(it);
+                out.write("\n");
+                out.pad(spacing);
+                param_basic_help.template identity<true, false>(out);
             }(), ...);
-            return it;
         }
         private:
             static constexpr auto param_name_max_length = impl::max_length<ParamsParser...>(2)+help::PADDING;
@@ -0,0 +1,195 @@
+#pragma once
+
+#ifndef GLAP_MODULE
+#include "../incremental.h"
+#include "../parser.h"
+#include "../model.h"
+#include <array>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+#endif
+
+namespace glap
+{
+    template <StringLiteral Name, model::DefaultCommand def_cmd, class... Commands>
+    class IncrementalParser<model::Program<Name, def_cmd, Commands...>> {
+    public:
+        using OutputType = model::Program<Name, def_cmd, Commands...>;
+
+        /// `options.resource` is used by the dynamic containers and by the pending arguments.
+        /// `options.presize` is ignored: the arguments are not known ahead.
+        /// `options.threads` and `options.pool` are ignored too: each value is resolved and validated serially, on the
+        /// thread feeding it, as soon as its argument is complete, so that the resolution overlaps the reading.
+        explicit IncrementalParser(ParseOptions options = {})
+            : m_options(options)
+            , m_pending(options.resource ? options.resource : std::pmr::get_default_resource())
+        {
+            m_options.threads = 0;
+            m_options.pool = nullptr;
+        }
+
+        /// Feeds the next argument. The parsed program keeps views on it, it must outlive the program.
+        constexpr void feed(std::string_view arg)
+        {
+            if (m_error) [[unlikely]]
+                return;
+            switch (m_stage) {
+            case Stage::Program:
+                m_program.program = arg;
+                m_stage = Stage::Command;
+                ++m_position;
+                return;
+            case Stage::Command:
+                if (!arg.starts_with("-")) {
+                    ++m_position;
+                    select_named(arg);
+                    return;
+                }
+                if (!select_default())
+                    return;
+                break;
+            case Stage::Arguments:
+                break;
+            }
+            m_pending.push_back(arg);
+            flush(false);
+        }
+        /// Feeds a batch of arguments.
+        constexpr void feed(impl::Range<std::string_view> auto args)
+        {
+            for (std::string_view arg : args)
+                feed(arg);
+        }
+        /// Ends the argument list. The result is the one `glap::parser<Program>` gives on the whole argument list.
+        /// The parser must not be used afterward.
+        constexpr auto finish() -> PosExpected<OutputType>
+        {
+            if (!m_error) {
+                switch (m_stage) {
+                case Stage::Program:
+                    return make_unexpected(PositionnedError{
+                        .error = Error{
+                            .parameter = "",
+                            .value = std::nullopt,
+                            .type = Error::Type::None,
+                            .code = Error::Code::NoParameter
+                        },
+                        .position = 0
+                    });
+                case Stage::Command:
+                    select_default();
+                    break;
+                case Stage::Arguments:
+                    flush(true);
+                    break;
+                }
+            }
+            if (m_error) [[unlikely]]
+                return make_unexpected(*m_error);
+            return std::move(m_program);
+        }
+    private:
+        using Iter = const std::string_view*;
+        enum class Stage {
+            Program,
+            Command,
+            Arguments
+        };
+        struct CommandEntry {
+            void(*select)(OutputType&, ParseOptions);
+            PosExpected<Iter>(*parse)(OutputType&, impl::BiIterator<Iter>);
+            size_t(*unit_size)(std::string_view);
+        };
+        template <size_t I>
+        using Command = std::variant_alternative_t<I, std::variant<Commands...>>;
+        template <size_t I>
+        static constexpr void select_at(OutputType& program, ParseOptions options)
+        {
+            program.command.template emplace<I>();
+            if (options.resource)
+                glap::parser<Command<I>>.parse(std::get<I>(program.command), impl::BiIterator<Iter>(nullptr, nullptr), ParseOptions{.resource = options.resource});
+        }
+        template <size_t I>
+        static constexpr auto parse_at(OutputType& program, impl::BiIterator<Iter> args) -> PosExpected<Iter>
+        {
+            return glap::parser<Command<I>>.parse(std::get<I>(program.command), args);
+        }
+        /// one entry per command, indexed like `impl::longname_table<Commands...>` and `impl::shortname_table<Commands...>`
+        static constexpr auto command_entries = []<size_t ...I>(std::index_sequence<I...>) {
+            return std::array<CommandEntry, sizeof...(I)>{CommandEntry{&select_at<I>, &parse_at<I>, &Parser<Command<I>>::unit_size}...};
+        }(std::index_sequence_for<Commands...>{});
+
+        constexpr bool select_default()
+        {
+            if constexpr (def_cmd == model::DefaultCommand::None) {
+                m_error = PositionnedError{
+                    .error = Error{
+                        .parameter = "",
+                        .value = std::nullopt,
+                        .type = Error::Type::Command,
+                        .code = Error::Code::NoGlobalCommand
+                    },
+                    .position = m_position
+                };
+                return false;
+            } else {
+                select(0);
+                return true;
+            }
+        }
+        constexpr void select_named(std::string_view name)
+        {
+            auto index = Parser<OutputType>::find_command(name);
+            if (!index) [[unlikely]] {
+                m_error = PositionnedError{
+                    .error = index.error(),
+                    .position = m_position
+                };
+                return;
+            }
+            select(index.value());
+        }
+        constexpr void select(size_t index)
+        {
+            m_command = index;
+            command_entries[index].select(m_program, m_options);
+            m_stage = Stage::Arguments;
+        }
+        /// Parses the complete units of the pending arguments, or all of them when `last`.
+        /// Only an incomplete unit (a short name cluster waiting for parameter values) stays pending.
+        constexpr void flush(bool last)
+        {
+            auto& entry = command_entries[m_command];
+            size_t done = 0;
+            while (done < m_pending.size()) {
+                auto size = last ? m_pending.size() - done : entry.unit_size(m_pending[done]);
+                if (m_pending.size() - done < size)
+                    break;
+                auto first = m_pending.data() + done;
+                auto res = entry.parse(m_program, impl::BiIterator<Iter>(first, first + size));
+                if (!res) [[unlikely]] {
+                    m_error = PositionnedError{
+                        .error = res.error().error,
+                        .position = res.error().position + m_position
+                    };
+                    return;
+                }
+                m_position += size;
+                done += size;
+            }
+            m_pending.erase(m_pending.begin(), m_pending.begin() + done);
+        }
+
+        ParseOptions m_options;
+        OutputType m_program;
+        std::pmr::vector<std::string_view> m_pending;
+        std::optional<PositionnedError> m_error;
+        PositionnedError::difference_type m_position = 0;
+        size_t m_command = 0;
+        Stage m_stage = Stage::Program;
+    };
+}
\ No newline at end of file
@@ -4,26 +4,63 @@
 #include "../parser.h"
 #include "../model.h"
 #include "glap/core/expected.h"
+#include "glap/core/lookup.h"
+#include "glap/core/parallel.h"
+#include "glap/core/suggest.h"
+#include <array>
+#include <atomic>
 #include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <optional>
+#include <ranges>
+#include <span>
 #include <string_view>
+#include <tuple>
 #include <variant>
+#include <vector>
 #endif
 
+namespace glap::impl
+{
+    /// Value collected by the parser, resolved once the arguments are all parsed (see `ParseOptions::threads`)
+    struct DeferredValue {
+        size_t argument;
+        std::string_view raw;
+        PositionnedError::difference_type position;
+    };
+    using DeferredValues = std::pmr::vector<DeferredValue>;
+
+    /// Arguments whose values can be resolved after the parsing: dynamic containers with a resolver or a validator
+    template <class Argument>
+    struct IsDeferrable : std::false_type
+    {};
+    template <class ArgNames, auto Resolver, auto Validator>
+    struct IsDeferrable<model::Parameters<ArgNames, discard, Resolver, Validator>>
+        : std::bool_constant<(IsResolver<decltype(Resolver)> || IsValidator<decltype(Validator)>) && !IsLazy<std::remove_cv_t<decltype(Resolver)>>::value>
+    {};
+    template <auto Resolver, auto Validator>
+    struct IsDeferrable<model::Inputs<discard, Resolver, Validator>>
+        : std::bool_constant<(IsResolver<decltype(Resolver)> || IsValidator<decltype(Validator)>) && !IsLazy<std::remove_cv_t<decltype(Resolver)>>::value>
+    {};
+
+    /// Values resolved from the deferred values of an argument, one entry per value in command line order
+    template <class Argument, bool = IsDeferrable<Argument>::value>
+    struct ResolvedValues {
+        explicit ResolvedValues(std::pmr::memory_resource*) noexcept
+        {}
+    };
+    template <class Argument>
+    struct ResolvedValues<Argument, true> {
+        std::pmr::vector<std::optional<typename Argument::value_type>> values;
+        explicit ResolvedValues(std::pmr::memory_resource* resource) : values(resource)
+        {}
+    };
+}
+
 namespace glap
 {
-    namespace impl {
-        template <HasLongName Command>
-        static constexpr bool check_names(std::optional<std::string_view> name, std::optional<char32_t> codepoint)
-        {
-            if (name && *name == Command::longname)
-                return true;
-            if constexpr(HasShortName<Command>)
-                if (codepoint && *codepoint == *Command::shortname)
-                    return true;
-            return false;
-        }
-    }
     template <class Model>
     class Parser<Parser<Model>>
     {
@@ -31,18 +68,32 @@ namespace glap
         using OutputType = Model;
     public:
         template <class Iter>
-        constexpr auto operator()(impl::BiIterator<Iter> args) const -> PosExpected<OutputType>
+        constexpr auto operator()(impl::BiIterator<Iter> args, ParseOptions options = {}) const -> PosExpected<OutputType>
         {
             OutputType result;
-            auto cmd = static_cast<const BaseType*>(this)->parse(result, args);
+            auto cmd = static_cast<const BaseType*>(this)->parse(result, args, options);
             if (!cmd)
                 return glap::make_unexpected(cmd.error());
             else
                 return result;
         }
-        constexpr auto operator()(impl::Range<std::string_view> auto args) const -> PosExpected<OutputType>
+        /// When `args` owns the memory its arguments point into (see `MappedArguments::storage`), the parsed program
+        /// keeps it alive, or the error if the parsing failed.
+        constexpr auto operator()(impl::Range<std::string_view> auto const& args, ParseOptions options = {}) const -> PosExpected<OutputType>
+        {
+            auto result = operator()(impl::BiIterator{args.begin(), args.end()}, options);
+            if constexpr (requires { args.storage(); result->storage; }) {
+                auto storage = args.storage();
+                if (result)
+                    result->storage.insert(result->storage.end(), storage.begin(), storage.end());
+                else if (!storage.empty())
+                    result.error().storage = std::make_shared<const std::vector<std::ranges::range_value_t<decltype(storage)>>>(storage.begin(), storage.end());
+            }
+            return result;
+        }
+        constexpr auto operator()(impl::Range<std::string_view> auto const& args, std::pmr::memory_resource* resource) const -> PosExpected<OutputType>
         {
-            return operator()(impl::BiIterator{args.begin(), args.end()});
+            return operator()(args, ParseOptions{.resource = resource});
         }
     };
     struct ParsedParameter
@@ -55,7 +106,7 @@ namespace glap
     public:
         using OutputType = model::Program<Name, def_cmd, Commands...>;
         template <class Iter>
-        constexpr auto parse(OutputType& program, impl::BiIterator<Iter> args) const -> PosExpected<Iter>
+        constexpr auto parse(OutputType& program, impl::BiIterator<Iter> args, ParseOptions options = {}) const -> PosExpected<Iter>
         {
             if (args.size() == 0) [[unlikely]] {
                 return make_unexpected(PositionnedError{
@@ -92,69 +143,105 @@ namespace glap
                         .position = std::distance(args.begin, itarg)
                     });
                 } else {
-                    program.command.template emplace<0>();
-                    result = glap::parser<std::variant_alternative_t<0, decltype(program.command)>>.parse(std::get<0>(program.command), impl::BiIterator(itarg, args.end));
+                    result = command_dispatch<Iter>[0](program, impl::BiIterator(itarg, args.end), options);
                 }
             }
             else {
                 auto name = *itarg++;
-                std::optional<char32_t> codepoint;
-                if (utils::uni::utf8_length(name) == 1) {
-                    auto res = utils::uni::codepoint(name);
-                    if (res) [[likely]] 
-                        codepoint = res.value();
-                    else 
-                        return make_unexpected(PositionnedError{
-                            .error = Error{
-                                .parameter = name,
-                                .value = std::nullopt,
-                                .type = Error::Type::Command,
-                                .code = Error::Code::BadString
-                            },
-                            .position = std::distance(args.begin, itarg)
-                        });
-                } else {
-                    codepoint = std::nullopt;
-                }
-
-                auto found = ([&]{
-                    if (impl::check_names<Commands>(name, codepoint)) {
-                        program.command.template emplace<Commands>();
-                        result = glap::parser<Commands>.parse(std::get<Commands>(program.command), impl::BiIterator(itarg, args.end));
-                        return true;
-                    }
-                    return false;
-                }() || ...);
-                if (!found) [[unlikely]] {
+                auto index = find_command(name);
+                if (!index) [[unlikely]] {
                     return make_unexpected(PositionnedError{
-                        .error = Error{
-                            .parameter = name,
-                            .value = std::nullopt,
-                            .type = Error::Type::Command,
-                            .code = Error::Code::BadCommand
-                        },
+                        .error = index.error(),
                         .position = std::distance(args.begin, itarg)
                     });
                 }
+                result = command_dispatch<Iter>[index.value()](program, impl::BiIterator(itarg, args.end), options);
             }
             if (!result) [[unlikely]] {
                 result.error().position += std::distance(args.begin, itarg);
             }
             return result;
         }
+        /// Index of the command called `name`, by long name or by short name (a single code point)
+        static constexpr auto find_command(std::string_view name) -> Expected<size_t>
+        {
+            auto index = impl::longname_table<Commands...>.find(name);
+            if (index == impl::npos_index && !name.empty()) {
+                auto char_len = utils::uni::utf8_char_length(name);
+                if (char_len && char_len.value() == name.size()) {
+                    auto res = utils::uni::codepoint(name);
+                    if (!res) [[unlikely]] {
+                        return make_unexpected(Error{
+                            .parameter = name,
+                            .value = std::nullopt,
+                            .type = Error::Type::Command,
+                            .code = Error::Code::BadString
+                        });
+                    }
+                    index = impl::shortname_table<Commands...>.find(res.value());
+                }
+            }
+            if (index == impl::npos_index) [[unlikely]] {
+                return make_unexpected(Error{
+                    .parameter = name,
+                    .value = std::nullopt,
+                    .type = Error::Type::Command,
+                    .code = Error::Code::BadCommand,
+                    .candidates = impl::longname_list<Commands...>
+                });
+            }
+            return index;
+        }
+    private:
+        template <class Iter>
+        using CommandDispatch = PosExpected<Iter>(*)(OutputType&, impl::BiIterator<Iter>, ParseOptions);
+        template <size_t I, class Iter>
+        static constexpr auto parse_command_at(OutputType& program, impl::BiIterator<Iter> args, ParseOptions options) -> PosExpected<Iter>
+        {
+            program.command.template emplace<I>();
+            return glap::parser<std::variant_alternative_t<I, decltype(program.command)>>.parse(std::get<I>(program.command), args, options);
+        }
+        /// one entry per command, indexed like `impl::longname_table<Commands...>` and `impl::shortname_table<Commands...>`
+        template <class Iter>
+        static constexpr auto command_dispatch = []<size_t ...I>(std::index_sequence<I...>) {
+            return std::array<CommandDispatch<Iter>, sizeof...(I)>{&parse_command_at<I, Iter>...};
+        }(std::index_sequence_for<Commands...>{});
     };
     template <HasLongName CommandNames, model::IsArgument... Arguments>
     class Parser<model::Command<CommandNames, Arguments...>> : public Parser<Parser<model::Command<CommandNames, Arguments...>>> {
     public:
         using OutputType = model::Command<CommandNames, Arguments...>;
         template <class Iter>
-        constexpr auto parse(OutputType& command, impl::BiIterator<Iter> params) const -> PosExpected<Iter>
+        constexpr auto parse(OutputType& command, impl::BiIterator<Iter> params, ParseOptions options = {}) const -> PosExpected<Iter>
         {
+            if (options.resource || options.presize) {
+                auto counts = options.presize ? count_values(params) : std::array<size_t, sizeof...(Arguments)>{};
+                [&]<size_t ...I>(std::index_sequence<I...>) {
+                    ([&] {
+                        auto& argument = std::get<I>(command.arguments);
+                        auto capacity = options.presize ? counts[I] : params.size();
+                        if constexpr(requires { argument.reserve(capacity); }) {
+                            if (options.resource)
+                                argument.use_resource(options.resource, capacity);
+                            else
+                                argument.reserve(capacity);
+                        }
+                    }(), ...);
+                }(std::index_sequence_for<Arguments...>{});
+            }
+            std::optional<impl::DeferredValues> deferred;
+            if constexpr ((impl::IsDeferrable<Arguments>::value || ...)) {
+                if (options.resolver_threads() > 1) {
+                    deferred.emplace(options.resource ? options.resource : std::pmr::get_default_resource());
+                    deferred->reserve(params.size());
+                }
+            }
+            auto deferred_ptr = deferred ? &*deferred : nullptr;
             auto itcurrent = params.begin;
             while(itcurrent != params.end) {
                 auto arg = *itcurrent;
                 if (arg.starts_with("---")) {
-                    return make_unexpected(PositionnedError{
+                    auto error = PositionnedError{
                         .error = Error{
                             .parameter = arg,
                             .value = std::nullopt,
@@ -162,15 +249,17 @@ namespace glap
                             .code = Error::Code::SyntaxError
                         },
                         .position = std::distance(params.begin, itcurrent)
-                    });
+                    };
+                    return make_unexpected(deferred ? *resolve_deferred(command, *deferred, options, error) : error);
                 } else {
+                    auto first_deferred = deferred ? deferred->size() : 0;
                     PosExpected<Iter> res;
                     if (arg.starts_with("--")) {
-                        res = parse_long<Iter>(command, {itcurrent, params.end});
+                        res = parse_long<Iter>(command, {itcurrent, params.end}, deferred_ptr);
                     } else if (arg.starts_with("-")) {
-                        res = parse_short<Iter>(command, {itcurrent, params.end});
+                        res = parse_short<Iter>(command, {itcurrent, params.end}, deferred_ptr);
                     } else {
-                        auto res_input = parse_input(command, arg);
+                        auto res_input = parse_input(command, arg, deferred_ptr);
                         if (!res_input) [[unlikely]] {
                             res = make_unexpected(PositionnedError{
                                 .error = res_input.error(),
@@ -180,56 +269,226 @@ namespace glap
                             res = std::next(itcurrent);
                         }
                     }
+                    if (deferred) {
+                        for (auto i = first_deferred; i < deferred->size(); ++i)
+                            (*deferred)[i].position += std::distance(params.begin, itcurrent);
+                    }
                     if (!res) [[unlikely]] {
-                        return make_unexpected(PositionnedError{
+                        auto error = PositionnedError{
                             .error = res.error().error,
                             .position = res.error().position + std::distance(params.begin, itcurrent)
-                        });
+                        };
+                        return make_unexpected(deferred ? *resolve_deferred(command, *deferred, options, error) : error);
                     } 
                     itcurrent = res.value();
                 }
             }
+            if (deferred) {
+                if (auto error = resolve_deferred(command, *deferred, options); error) [[unlikely]]
+                    return make_unexpected(*error);
+            }
             return params.begin;
         }
+        /// Number of arguments parsed together with `arg`, `arg` included: one, plus the value of each parameter of a
+        /// short name cluster. Malformed or unknown short names end the count, they are reported by the parsing.
+        static constexpr auto unit_size(std::string_view arg) -> size_t
+        {
+            if (!arg.starts_with("-") || arg.starts_with("--"))
+                return 1;
+            size_t size = 1;
+            auto list_names = arg.substr(1);
+            for (size_t pos = 0; pos < list_names.size();) {
+                auto codepoint = utils::uni::next_codepoint(list_names, pos);
+                if (!codepoint)
+                    break;
+                auto index = impl::shortname_table<Arguments...>.find(codepoint.value());
+                if (index == impl::npos_index)
+                    break;
+                if (argument_types[index] == glap::model::ArgumentType::Parameter)
+                    ++size;
+            }
+            return size;
+        }
     private:
+        using difference_type = PositionnedError::difference_type;
+        /// `deferred` collects the values of deferrable arguments instead of parsing them, with their error `position`
+        using ArgumentDispatch = bool(*)(OutputType&, std::optional<std::string_view>, Expected<void>&, impl::DeferredValues*, difference_type);
+        template <size_t I>
+        static constexpr bool parse_argument_at(OutputType& command, std::optional<std::string_view> value, Expected<void>& res, [[maybe_unused]] impl::DeferredValues* deferred, [[maybe_unused]] difference_type position)
+        {
+            using Argument = std::tuple_element_t<I, typename OutputType::Params>;
+            if constexpr(glap::model::IsArgumentTyped<Argument, glap::model::ArgumentType::Flag>) {
+                if (value)
+                    return false;
+                res = glap::parser<Argument>.parse(std::get<I>(command.arguments));
+                return true;
+            } else if constexpr(glap::model::IsArgumentTyped<Argument, glap::model::ArgumentType::Parameter>) {
+                if (!value)
+                    return false;
+                if constexpr (impl::IsDeferrable<Argument>::value) {
+                    if (deferred) {
+                        deferred->push_back(impl::DeferredValue{I, *value, position});
+                        return true;
+                    }
+                }
+                res = glap::parser<Argument>.parse(std::get<I>(command.arguments), *value);
+                return true;
+            } else {
+                return false;
+            }
+        }
+        /// one entry per argument, indexed like `impl::longname_table<Arguments...>` and `impl::shortname_table<Arguments...>`
+        static constexpr auto argument_dispatch = []<size_t ...I>(std::index_sequence<I...>) {
+            return std::array<ArgumentDispatch, sizeof...(I)>{&parse_argument_at<I>...};
+        }(std::index_sequence_for<Arguments...>{});
+        static constexpr auto argument_types = std::array<glap::model::ArgumentType, sizeof...(Arguments)>{Arguments::type...};
+
+        static constexpr auto input_index = [] {
+            for (size_t i = 0; i < argument_types.size(); ++i) {
+                if (argument_types[i] == glap::model::ArgumentType::Input)
+                    return i;
+            }
+            return impl::npos_index;
+        }();
+        using ResolvedValues = std::tuple<impl::ResolvedValues<Arguments>...>;
+        using ResolveDispatch = Expected<void>(*)(ResolvedValues&, std::string_view, size_t);
+        /// Resolves `raw`, a deferred value of the argument `I`, into the entry `slot` of its resolved values.
+        template <size_t I>
+        static auto resolve_value_at([[maybe_unused]] ResolvedValues& resolved, [[maybe_unused]] std::string_view raw, [[maybe_unused]] size_t slot) -> Expected<void>
+        {
+            using Argument = std::tuple_element_t<I, typename OutputType::Params>;
+            if constexpr (impl::IsDeferrable<Argument>::value) {
+                auto result = Parser<Argument>::resolve(raw);
+                if (!result) [[unlikely]]
+                    return make_unexpected(result.error());
+                std::get<I>(resolved).values[slot].emplace(std::move(result.value()));
+            }
+            return {};
+        }
+        /// one entry per argument, indexed like `impl::DeferredValue::argument`
+        static constexpr auto resolve_dispatch = []<size_t ...I>(std::index_sequence<I...>) {
+            return std::array<ResolveDispatch, sizeof...(I)>{&resolve_value_at<I>...};
+        }(std::index_sequence_for<Arguments...>{});
+        /// Resolves the deferred values of all the arguments in a single pass, on the threads of `options.pool` or on
+        /// `options.threads` threads, and pushes them if they are all valid. Values collected after `error` are skipped.
+        /// Returns the first error by position, `error` included.
+        static auto resolve_deferred(OutputType& command, std::span<const impl::DeferredValue> deferred, const ParseOptions& options, std::optional<PositionnedError> error = std::nullopt) -> std::optional<PositionnedError>
+        {
+            auto resource = options.resource ? options.resource : std::pmr::get_default_resource();
+            // entry of each deferred value in the resolved values of its argument
+            std::pmr::vector<size_t> slots(deferred.size(), resource);
+            std::array<size_t, sizeof...(Arguments)> counts = {};
+            for (size_t i = 0; i < deferred.size(); ++i)
+                slots[i] = counts[deferred[i].argument]++;
+            auto resolved = ResolvedValues{impl::ResolvedValues<Arguments>(resource)...};
+            [&]<size_t ...I>(std::index_sequence<I...>) {
+                ([&] {
+                    if constexpr (requires { std::get<I>(resolved).values; })
+                        std::get<I>(resolved).values.resize(counts[I]);
+                }(), ...);
+            }(std::index_sequence_for<Arguments...>{});
+            // deferred values are collected in command line order, so the lowest invalid index is the first error.
+            // `first_invalid` is only lowered with `invalid_mutex` held, together with `first_error`.
+            std::atomic<size_t> first_invalid = deferred.size();
+            std::mutex invalid_mutex;
+            std::optional<Error> first_error;
+            auto work = [&](size_t begin, size_t end) {
+                for (auto i = begin; i < end && i < first_invalid.load(std::memory_order_relaxed); ++i) {
+                    const auto& value = deferred[i];
+                    if (error && value.position >= error->position)
+                        continue;
+                    if (auto result = resolve_dispatch[value.argument](resolved, value.raw, slots[i]); !result) [[unlikely]] {
+                        std::scoped_lock lock(invalid_mutex);
+                        if (i < first_invalid.load(std::memory_order_relaxed)) {
+                            first_invalid.store(i, std::memory_order_relaxed);
+                            first_error = result.error();
+                        }
+                        return;
+                    }
+                }
+            };
+            if (options.pool)
+                options.pool->parallel_for(deferred.size(), work);
+            else
+                impl::parallel_for(deferred.size(), options.threads, work);
+            if (first_error) [[unlikely]] {
+                return PositionnedError{
+                    .error = *first_error,
+                    .position = deferred[first_invalid].position
+                };
+            }
+            if (error)
+                return error;
+            [&]<size_t ...I>(std::index_sequence<I...>) {
+                ([&] {
+                    if constexpr (requires { std::get<I>(resolved).values; }) {
+                        auto& argument = std::get<I>(command.arguments);
+                        auto& values = std::get<I>(resolved).values;
+                        argument.reserve(argument.size() + values.size());
+                        for (auto& value : values)
+                            argument.values.push_back(std::move(*value));
+                    }
+                }(), ...);
+            }(std::index_sequence_for<Arguments...>{});
+            return std::nullopt;
+        }
+        /// First pass over the arguments: counts the values each argument would receive.
+        /// Malformed or unknown arguments are skipped, they are reported by the parsing pass.
         template <class Iter>
-        constexpr auto parse_long(OutputType& command, impl::BiIterator<Iter> params) const -> PosExpected<Iter>
+        static constexpr auto count_values(impl::BiIterator<Iter> params) -> std::array<size_t, sizeof...(Arguments)>
+        {
+            std::array<size_t, sizeof...(Arguments)> counts = {};
+            for (auto itcurrent = params.begin; itcurrent != params.end;) {
+                std::string_view arg = *itcurrent++;
+                if (arg.starts_with("--")) {
+                    auto name_value = arg.substr(2);
+                    auto pos_equal = name_value.find('=');
+                    if (pos_equal == std::string_view::npos)
+                        continue;
+                    auto index = impl::longname_table<Arguments...>.find(name_value.substr(0, pos_equal));
+                    if (index != impl::npos_index)
+                        ++counts[index];
+                } else if (arg.starts_with("-")) {
+                    auto list_names = arg.substr(1);
+                    for (size_t pos = 0; pos < list_names.size();) {
+                        auto codepoint = utils::uni::next_codepoint(list_names, pos);
+                        if (!codepoint)
+                            break;
+                        auto index = impl::shortname_table<Arguments...>.find(codepoint.value());
+                        if (index != impl::npos_index && argument_types[index] == glap::model::ArgumentType::Parameter && itcurrent != params.end) {
+                            ++itcurrent;
+                            ++counts[index];
+                        }
+                    }
+                } else if (input_index != impl::npos_index) {
+                    ++counts[input_index];
+                }
+            }
+            return counts;
+        }
+
+        template <class Iter>
+        constexpr auto parse_long(OutputType& command, impl::BiIterator<Iter> params, impl::DeferredValues* deferred) const -> PosExpected<Iter>
         {
             auto arg = *params.begin++;
             auto name_value = arg.substr(2);
             auto pos_equal = name_value.find('=');
             auto name = name_value.substr(0, pos_equal);
+            std::optional<std::string_view> value;
+            if (pos_equal != std::string_view::npos)
+                value = name_value.substr(pos_equal + 1);
             Expected<void> res;
-            bool found = false;
-            if (pos_equal == std::string_view::npos) {
-                found = ([&]{
-                    if constexpr(glap::model::IsArgumentTyped<Arguments, glap::model::ArgumentType::Flag>) {
-                        if (impl::check_names<Arguments>(name, std::nullopt)) {
-                            res = glap::parser<Arguments>.parse(std::get<Arguments>(command.arguments));
-                            return true;
-                        }
-                    }
-                    return false;
-                }() || ...);
-            } else {
-                auto value = name_value.substr(pos_equal + 1);
-                found = ([&]{
-                    if constexpr(glap::model::IsArgumentTyped<Arguments, glap::model::ArgumentType::Parameter>) {
-                        if (impl::check_names<Arguments>(name, std::nullopt)) {
-                            res = glap::parser<Arguments>.parse(std::get<Arguments>(command.arguments), value);
-                            return true;
-                        }
-                    }
-                    return false;
-                }() || ...);
-            }
+            auto index = impl::longname_table<Arguments...>.find(name);
+            bool found = index != impl::npos_index && argument_dispatch[index](command, value, res, deferred, 0);
             if (!found) [[unlikely]] {
                 return make_unexpected(PositionnedError{
                     .error = Error{
                         .parameter = name,
                         .value = std::nullopt,
                         .type = Error::Type::Unknown,
-                        .code = Error::Code::UnknownArgument
+                        .code = Error::Code::UnknownArgument,
+                        // a known name refused for the shape of its value (`--flag=x`, `--param` alone) has no better name
+                        .candidates = index == impl::npos_index ? std::span<const std::string_view>(impl::longname_list<Arguments...>) : std::span<const std::string_view>()
                     },
                     .position = 0
                 });
@@ -243,28 +502,15 @@ namespace glap
             return params.begin;
         }
         template <class Iter>
-        constexpr auto parse_short(OutputType& command, impl::BiIterator<Iter> params) const -> PosExpected<Iter>
+        constexpr auto parse_short(OutputType& command, impl::BiIterator<Iter> params, impl::DeferredValues* deferred) const -> PosExpected<Iter>
         {
             auto itcurrent = params.begin;
             auto arg = *itcurrent++;
             auto list_names = arg.substr(1);
-            auto len_res = utils::uni::utf8_char_length(std::string_view(list_names));
-            if (!len_res) [[unlikely]] {
-                return make_unexpected(PositionnedError{
-                    .error = Error{
-                        .parameter = list_names,
-                        .value = std::nullopt,
-                        .type = Error::Type::Unknown,
-                        .code = Error::Code::BadString
-                    },
-                    .position = std::distance(params.begin, itcurrent)
-                });
-            }
-            auto len = len_res.value();
-            auto ch = list_names;
-            for(auto it = list_names.begin(); it != list_names.end(); it = std::next(it,len ), ch=std::string_view(it, list_names.end())) {
-                len_res = utils::uni::utf8_char_length(ch);
-                if (!len_res) [[unlikely]] {
+            for (size_t pos = 0; pos < list_names.size();) {
+                auto ch = list_names.substr(pos);
+                auto codepoint = utils::uni::next_codepoint(list_names, pos);
+                if (!codepoint) [[unlikely]] {
                     return make_unexpected(PositionnedError{
                         .error = Error{
                             .parameter = ch,
@@ -275,46 +521,8 @@ namespace glap
                         .position = std::distance(params.begin, itcurrent)
                     });
                 }
-                len = len_res.value();
-                auto codepoint_res = utils::uni::codepoint(ch);
-                if (!codepoint_res) [[unlikely]] {
-                    return make_unexpected(PositionnedError{
-                        .error = Error{
-                            .parameter = ch,
-                            .value = std::nullopt,
-                            .type = Error::Type::Unknown,
-                            .code = Error::Code::BadString
-                        },
-                        .position = std::distance(params.begin, itcurrent)
-                    });
-                }
-                auto codepoint = codepoint_res.value();
-                Expected<void> res;
-
-                bool found = ([&]{
-                    if constexpr(!glap::model::IsArgumentTyped<Arguments, glap::model::ArgumentType::Input>) {
-                        if (impl::check_names<Arguments>(std::nullopt, codepoint)) {
-                            if constexpr(glap::model::IsArgumentTyped<Arguments, glap::model::ArgumentType::Flag>) {
-                                res = glap::parser<Arguments>.parse(std::get<Arguments>(command.arguments));
-                            } else if constexpr(glap::model::IsArgumentTyped<Arguments, glap::model::ArgumentType::Parameter>) {
-                                if (itcurrent == params.end) {
-                                    res = make_unexpected(Error{
-                                        .parameter = ch,
-                                        .value = std::nullopt,
-                                        .type = Error::Type::Parameter,
-                                        .code = Error::Code::MissingValue
-                                    });
-                                } else {
-                                    res = glap::parser<Arguments>.parse(std::get<Arguments>(command.arguments), *itcurrent++);
-                                }
-                            }
-                            return true;
-                        }
-                    }
-                    return false;
-                }() || ...);
-
-                if (!found) [[unlikely]] {
+                auto index = impl::shortname_table<Arguments...>.find(codepoint.value());
+                if (index == impl::npos_index) [[unlikely]] {
                     return make_unexpected(PositionnedError{
                         .error = Error{
                             .parameter = arg,
@@ -325,6 +533,22 @@ namespace glap
                         .position = 0
                     });
                 }
+                Expected<void> res;
+                if (argument_types[index] == glap::model::ArgumentType::Parameter) {
+                    if (itcurrent == params.end) {
+                        res = make_unexpected(Error{
+                            .parameter = ch,
+                            .value = std::nullopt,
+                            .type = Error::Type::Parameter,
+                            .code = Error::Code::MissingValue
+                        });
+                    } else {
+                        auto value = *itcurrent++;
+                        argument_dispatch[index](command, value, res, deferred, std::distance(params.begin, itcurrent));
+                    }
+                } else {
+                    argument_dispatch[index](command, std::nullopt, res, deferred, 0);
+                }
                 if (!res) {
                     return make_unexpected(PositionnedError{
                         .error = res.error(),
@@ -336,11 +560,17 @@ namespace glap
             return itcurrent;
         }
 
-        constexpr auto parse_input(OutputType& command, std::string_view input) const -> Expected<void>
+        constexpr auto parse_input([[maybe_unused]] OutputType& command, [[maybe_unused]] std::string_view input, [[maybe_unused]] impl::DeferredValues* deferred) const -> Expected<void>
         {
             Expected<void> res;
             auto found = ([&] {
                 if constexpr(glap::model::IsArgumentTyped<Arguments, glap::model::ArgumentType::Input>) {
+                    if constexpr (impl::IsDeferrable<Arguments>::value) {
+                        if (deferred) {
+                            deferred->push_back(impl::DeferredValue{input_index, input, 0});
+                            return true;
+                        }
+                    }
                     res = glap::parser<Arguments>.parse(std::get<Arguments>(command.arguments), input);
                     return true;
                 } else {
@@ -368,36 +598,6 @@ namespace glap
             return {};
         }
     };
-    template <class OutputType, auto Resolver, auto Validator>
-    auto check_value(std::string_view value) -> Expected<OutputType>
-    {
-        if constexpr (IsValidator<decltype(Validator)>) {
-            if (!Validator(value)) [[unlikely]] {
-                return make_unexpected(Error{
-                    .parameter = std::string_view(),
-                    .value = value,
-                    .type = Error::Type::Parameter,
-                    .code = Error::Code::BadValidation
-                });
-            }
-        }
-        if constexpr (IsResolver<decltype(Resolver)>) {
-            auto result = Resolver(value);
-            if constexpr (IsExpected<decltype(result)>) {
-                if (!result) [[unlikely]] {
-                    return make_unexpected(Error{
-                        .parameter = std::string_view(),
-                        .value = value,
-                        .type = Error::Type::Parameter,
-                        .code = Error::Code::BadResolution
-                    });
-                }
-            }
-            return *result;
-        } else {
-            return value;
-        }
-    }
     template <class ArgNames, auto Resolver, auto Validator>
     class Parser<model::Parameter<ArgNames, Resolver, Validator>> {
         using OutputType = model::Parameter<ArgNames, Resolver, Validator>;
@@ -436,13 +636,17 @@ namespace glap
                     });
                 }
             }
-            auto result = check_value<typename OutputType::value_type, Resolver, Validator>(value);
+            auto result = resolve(value);
             if (!result) [[unlikely]] {
                 return make_unexpected(result.error());
             }
             params.values.push_back(std::move(result.value()));
             return {};
         }
+        static constexpr auto resolve(std::string_view value) -> Expected<typename OutputType::value_type>
+        {
+            return check_value<typename OutputType::value_type, Resolver, Validator>(value);
+        }
     };
     template <auto Resolver, auto Validator>
     class Parser<model::Input<Resolver, Validator>> {
@@ -482,13 +686,19 @@ namespace glap
                     });
                 }
             }
-            auto result = check_value<typename OutputType::value_type, Resolver, Validator>(value);
+            auto result = resolve(value);
             if (!result) [[unlikely]] {
-                result.error().type = Error::Type::Input;
                 return make_unexpected(result.error());
             }
             inputs.values.push_back(std::move(result.value()));
             return {};
         }
+        static constexpr auto resolve(std::string_view value) -> Expected<typename OutputType::value_type>
+        {
+            auto result = check_value<typename OutputType::value_type, Resolver, Validator>(value);
+            if (!result) [[unlikely]]
+                result.error().type = Error::Type::Input;
+            return result;
+        }
     };
 }
\ No newline at end of file
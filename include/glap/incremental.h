@@ -0,0 +1,18 @@
+#pragma once
+
+#ifndef GLAP_MODULE
+#include "core/base.h"
+#include "parser.h"
+#endif
+
+GLAP_EXPORT namespace glap
+{
+    /// Parser fed with the arguments as they arrive, see [PARSERS.md](../../docs/PARSERS.md#incremental-parser).
+    template <class>
+    class IncrementalParser
+    {};
+}
+
+#ifndef GLAP_MODULE
+#include "impl/incremental.inl"
+#endif
\ No newline at end of file
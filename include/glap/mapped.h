@@ -0,0 +1,97 @@
+#pragma once
+
+#ifndef GLAP_MODULE
+#include "core/base.h"
+#include "core/expected.h"
+#include "core/utils.h"
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#endif
+
+GLAP_EXPORT namespace glap
+{
+    /// Read only memory mapping of a whole file. Files which cannot be mapped (pipes, `/dev/stdin`...) are read until
+    /// their end into an owned buffer instead.
+    class MappedFile {
+    public:
+        static auto open(const std::filesystem::path& path) -> expected<std::shared_ptr<const MappedFile>, std::error_code>;
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        [[nodiscard]] std::string_view content() const noexcept {
+            return {m_data, m_size};
+        }
+    private:
+        MappedFile() = default;
+        const char* m_data = nullptr;
+        std::size_t m_size = 0;
+        /// Content of a file read instead of mapped
+        std::string m_buffer;
+    };
+
+    /// Arguments pointing straight into memory mapped files. It is a range of `std::string_view`, usable by the
+    /// parser, which then keeps the mappings alive in `Program::storage`.
+    class MappedArguments {
+    public:
+        /// Maps the file at `path` and splits it into arguments.
+        /// Arguments are delimited by NUL bytes if the file contains any, by new lines otherwise.
+        static auto open(const std::filesystem::path& path) -> expected<MappedArguments, std::error_code>
+        {
+            MappedArguments result;
+            if (auto res = result.append_file(path); !res) [[unlikely]]
+                return unexpected<std::error_code>(res.error());
+            return result;
+        }
+        /// Views `args` and replaces each `@file` argument by the arguments of the mapped file (not recursively).
+        static auto expand(impl::Range<std::string_view> auto const& args) -> expected<MappedArguments, std::error_code>
+        {
+            MappedArguments result;
+            for (std::string_view arg : args) {
+                if (arg.size() > 1 && arg.front() == '@') {
+                    if (auto res = result.append_file(arg.substr(1)); !res) [[unlikely]]
+                        return unexpected<std::error_code>(res.error());
+                } else {
+                    result.m_arguments.push_back(arg);
+                }
+            }
+            return result;
+        }
+        /// Same as above, with the arguments of `main`.
+        static auto expand(int argc, const char* const* argv) -> expected<MappedArguments, std::error_code>
+        {
+            std::vector<std::string_view> args(argv, argv + argc);
+            return expand(args);
+        }
+
+        [[nodiscard]] auto begin() const noexcept {
+            return m_arguments.begin();
+        }
+        [[nodiscard]] auto end() const noexcept {
+            return m_arguments.end();
+        }
+        [[nodiscard]] auto size() const noexcept {
+            return m_arguments.size();
+        }
+        [[nodiscard]] std::string_view operator[](std::size_t i) const noexcept {
+            return m_arguments[i];
+        }
+        /// Mappings the arguments point into.
+        [[nodiscard]] auto storage() const noexcept -> std::span<const std::shared_ptr<const MappedFile>> {
+            return m_files;
+        }
+    private:
+        MappedArguments() = default;
+        auto append_file(const std::filesystem::path& path) -> expected<void, std::error_code>;
+
+        std::vector<std::string_view> m_arguments;
+        std::vector<std::shared_ptr<const MappedFile>> m_files;
+    };
+}
\ No newline at end of file
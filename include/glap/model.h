@@ -6,7 +6,12 @@
 #include "core/utils.h"
 #include "core/container.h"
 #include "core/value.h"
+#include <algorithm>
+#include <memory>
+#include <string_view>
+#include <tuple>
 #include <variant>
+#include <vector>
 #endif
 
 GLAP_EXPORT namespace glap::model
@@ -28,16 +33,16 @@ GLAP_EXPORT namespace glap::model
 
     template <class ArgNames, auto Resolver = discard, auto Validator = discard>
     struct Parameter : ArgNames, Value<Resolver, Validator> {
-        using value_type = typename impl::ResolverReturnType<decltype(Resolver)>::type;
+        using value_type = impl::value_type_t<Resolver, Validator>;
         constexpr Parameter() = default;
-        constexpr Parameter(std::string_view v) : Value<Resolver, Validator>(v)
+        constexpr Parameter(value_type v) : Value<Resolver, Validator>(std::move(v))
         {}
         static constexpr auto type = ArgumentType::Parameter;
     };
 
     template <class ArgNames, auto N = discard, auto Resolver = discard, auto Validator = discard>
     struct Parameters : ArgNames, Container<Parameter<ArgNames, Resolver, Validator>, N> {
-        using value_type = typename impl::ResolverReturnType<decltype(Resolver)>::type;
+        using value_type = impl::value_type_t<Resolver, Validator>;
         static constexpr auto resolver = Resolver;
         static constexpr auto validator = Validator;
         static constexpr auto type = ArgumentType::Parameter;
@@ -49,15 +54,15 @@ GLAP_EXPORT namespace glap::model
     };
     template <auto Resolver = discard, auto Validator = discard>
     struct Input : Value<Resolver, Validator> {
-        using value_type = typename impl::ResolverReturnType<decltype(Resolver)>::type;
+        using value_type = impl::value_type_t<Resolver, Validator>;
         constexpr Input() = default;
-        constexpr Input(std::string_view v) : Value<Resolver, Validator>(v)
+        constexpr Input(value_type v) : Value<Resolver, Validator>(std::move(v))
         {}
         static constexpr auto type = ArgumentType::Input;
     };
     template <auto N = discard, auto Resolver = discard, auto Validator = discard>
     struct Inputs : Container<Input<Resolver, Validator>, N> {
-        using value_type = typename impl::ResolverReturnType<decltype(Resolver)>::type;
+        using value_type = impl::value_type_t<Resolver, Validator>;
         static constexpr auto resolver = Resolver;
         static constexpr auto validator = Validator;
         static constexpr auto type = ArgumentType::Input;
@@ -118,5 +123,151 @@ GLAP_EXPORT namespace glap::model
         static constexpr auto default_command = def_cmd;
         std::string_view program;
         std::variant<Commands...> command;
+        /// Memory the parsed views point into (mapped argument files...), kept alive with the program.
+        std::vector<std::shared_ptr<const void>> storage;
     };
+}
+
+namespace glap::impl
+{
+    template <class Arg>
+    constexpr auto validate_value(const auto& value) -> Expected<void> {
+        if (!value)
+            return {};
+        if (auto& res = value->get(); !res) [[unlikely]] {
+            auto error = res.error();
+            if constexpr (HasLongName<Arg>)
+                error.parameter = Arg::longname;
+            if constexpr (model::IsArgumentTyped<Arg, model::ArgumentType::Input>)
+                error.type = Error::Type::Input;
+            return make_unexpected(error);
+        }
+        return {};
+    }
+    /// Copies the bytes viewed by string views and lazy values of a parsed model into a single allocation.
+    /// Views are measured first (`reserve`), then the pool is allocated once and views are moved into it (`copy`).
+    class StringPool {
+        size_t m_size = 0;
+        std::shared_ptr<char[]> m_pool;
+        char* m_pos = nullptr;
+
+        auto copy_bytes(std::string_view bytes) -> std::string_view {
+            auto start = m_pos;
+            m_pos = std::copy(bytes.begin(), bytes.end(), m_pos);
+            return std::string_view(start, bytes.size());
+        }
+    public:
+        template <class T>
+        void reserve(const T& value) noexcept {
+            if constexpr (std::same_as<T, std::string_view>)
+                m_size += value.size();
+            else if constexpr (IsLazyValue<T>::value)
+                m_size += value.raw().size();
+        }
+        void allocate() {
+            if (m_size > 0)
+                m_pool = std::make_shared_for_overwrite<char[]>(m_size);
+            m_pos = m_pool.get();
+        }
+        /// Lazy values are rebuilt on the copy, so they are resolved again on next access.
+        template <class T>
+        void copy(T& value) {
+            if constexpr (std::same_as<T, std::string_view>)
+                value = copy_bytes(value);
+            else if constexpr (IsLazyValue<T>::value)
+                value = T(copy_bytes(value.raw()));
+        }
+        [[nodiscard]] auto release() noexcept -> std::shared_ptr<char[]> {
+            return std::move(m_pool);
+        }
+    };
+    /// Whether the argument received a value (or an occurence, for flags)
+    template <class Argument>
+    constexpr auto is_set(const Argument& argument) noexcept -> bool {
+        if constexpr (model::IsArgumentTyped<Argument, model::ArgumentType::Flag>)
+            return argument.occurences > 0;
+        else if constexpr (requires { argument.values; })
+            return argument.values.size() > 0;
+        else
+            return argument.value.has_value();
+    }
+    /// Calls `f` on every value of the command
+    template <class CommandNames, class... Arguments, class F>
+    constexpr void for_each_value(model::Command<CommandNames, Arguments...>& command, F&& f) {
+        std::apply([&f](auto&... args) {
+            ([&f](auto& arg) {
+                if constexpr (model::IsArgumentTyped<std::remove_cvref_t<decltype(arg)>, model::ArgumentType::Flag>) {
+                    return;
+                } else if constexpr (requires { arg.values; }) {
+                    for (auto& element : arg.values)
+                        f(arg.value_of(element));
+                } else if (arg.value) {
+                    f(*arg.value);
+                }
+            }(args), ...);
+        }, command.arguments);
+    }
+    template <class Arg>
+    constexpr auto validate_argument(const Arg& arg) -> Expected<void> {
+        if constexpr (model::IsArgumentTyped<Arg, model::ArgumentType::Flag>) {
+            return {};
+        } else if constexpr (!IsLazy<std::remove_cv_t<decltype(Arg::resolver)>>::value) {
+            return {};
+        } else if constexpr (requires { arg.values; }) {
+            for (const auto& v : arg.values) {
+                if (auto res = validate_value<Arg>(v.value); !res)
+                    return res;
+            }
+            return {};
+        } else {
+            return validate_value<Arg>(arg.value);
+        }
+    }
+}
+
+GLAP_EXPORT namespace glap
+{
+    /// Resolves every lazy value of the command now, and returns the first error.
+    template <class CommandNames, class... Arguments>
+    constexpr auto validate_all(const model::Command<CommandNames, Arguments...>& command) -> Expected<void> {
+        auto result = Expected<void>{};
+        std::apply([&result](const auto&... args) {
+            (void)((result = impl::validate_argument(args)) && ...);
+        }, command.arguments);
+        return result;
+    }
+    /// Resolves every lazy value of the selected command now, and returns the first error.
+    template <StringLiteral Name, model::DefaultCommand def_cmd, class... Commands>
+    constexpr auto validate_all(const model::Program<Name, def_cmd, Commands...>& program) -> Expected<void> {
+        return std::visit([](const auto& command) {
+            return validate_all(command);
+        }, program.command);
+    }
+    /// Copies the bytes viewed by the string values and raw lazy values of the command into one allocation, and
+    /// points the values to it. The command no longer depends on the parsed arguments afterwards.
+    /// @return the allocation, to keep alive as long as the command (null if nothing is viewed)
+    template <class CommandNames, class... Arguments>
+    auto detach(model::Command<CommandNames, Arguments...>& command) -> std::shared_ptr<const char[]> {
+        auto pool = impl::StringPool{};
+        impl::for_each_value(command, [&pool](const auto& value) { pool.reserve(value); });
+        pool.allocate();
+        impl::for_each_value(command, [&pool](auto& value) { pool.copy(value); });
+        return pool.release();
+    }
+    /// Copies the program name and the values of the selected command into one allocation, owned by `storage`.
+    template <StringLiteral Name, model::DefaultCommand def_cmd, class... Commands>
+    void detach(model::Program<Name, def_cmd, Commands...>& program) {
+        auto pool = impl::StringPool{};
+        pool.reserve(program.program);
+        std::visit([&pool](auto& command) {
+            impl::for_each_value(command, [&pool](const auto& value) { pool.reserve(value); });
+        }, program.command);
+        pool.allocate();
+        pool.copy(program.program);
+        std::visit([&pool](auto& command) {
+            impl::for_each_value(command, [&pool](auto& value) { pool.copy(value); });
+        }, program.command);
+        if (auto storage = pool.release())
+            program.storage.push_back(std::move(storage));
+    }
 }
\ No newline at end of file
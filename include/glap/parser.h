@@ -8,13 +8,38 @@
 #include "core/utf8.h"
 #include "core/utils.h"
 #include "core/biiterator.h"
+#include "core/parallel.h"
 #include "model.h"
+#include <memory_resource>
 #include <type_traits>
 #include <utility>
 #endif
 
 GLAP_EXPORT namespace glap
 {
+    struct ParseOptions {
+        /// Memory resource of the dynamic containers (Parameters, Inputs) of the parsed command.
+        /// When set, each container makes a single allocation sized for the number of remaining arguments.
+        /// The collected values of `threads` and their scratch buffers are allocated from it too.
+        /// The resource must outlive the parsed model.
+        std::pmr::memory_resource* resource = nullptr;
+        /// Counts the values of each argument in a first pass over the arguments, so the dynamic containers reserve
+        /// exactly what they need instead of growing (or instead of reserving the number of remaining arguments).
+        bool presize = false;
+        /// Number of threads resolving and validating the values of dynamic `Parameters` and `Inputs` with a resolver or
+        /// a validator. The parser collects these values, then resolves them all in chunks on `threads` threads (the
+        /// calling one included), started by the parse. 0 or 1 resolves each value as soon as it is parsed. Resolvers
+        /// and validators must be thread safe and must not throw.
+        unsigned threads = 0;
+        /// Workers resolving the collected values instead of threads started by each parse, reused from one parse to
+        /// the next. When set, `threads` is ignored and the values are collected if the pool has several threads.
+        ThreadPool* pool = nullptr;
+
+        /// Number of threads resolving the collected values; 0 or 1 when values are resolved as soon as parsed
+        [[nodiscard]] auto resolver_threads() const noexcept -> unsigned {
+            return pool ? pool->size() : threads;
+        }
+    };
     template <class>
     class Parser
     {};
@@ -0,0 +1,335 @@
+#pragma once
+
+#ifndef GLAP_MODULE
+#include "core/base.h"
+#include "core/error.h"
+#include "core/expected.h"
+#include "core/lookup.h"
+#include "model.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#endif
+
+namespace glap::impl
+{
+    /// Snapshot layout, in native byte order and without padding:
+    /// - header: "GLAP", u32 version, u32 signature of the model
+    /// - program: u32 length and bytes of the program name, u32 index of the command, then the command
+    /// - command: one presence bit per argument (bit i%8 of byte i/8), then the payload of each present argument
+    /// - payloads: u64 occurences for flags, one value for parameters and inputs, u32 count and values for lists
+    /// - values: u32 length and bytes for string views and lazy values, object bytes for trivially copyable values
+    inline constexpr std::string_view snapshot_magic = "GLAP";
+    inline constexpr std::uint32_t snapshot_version = 1;
+
+    constexpr std::uint32_t hash_combine(std::uint32_t hash, std::uint32_t value) noexcept {
+        return (hash ^ value) * 16777619u;
+    }
+
+    template <class Argument>
+    consteval auto argument_signature() noexcept -> std::uint32_t {
+        auto hash = hash_combine(hash_name(longname_of<Argument>().value_or(std::string_view{})), static_cast<std::uint32_t>(Argument::type));
+        if constexpr (!model::IsArgumentTyped<Argument, model::ArgumentType::Flag>) {
+            using value_type = typename Argument::value_type;
+            hash = hash_combine(hash, IsLazyValue<value_type>::value ? 0u : static_cast<std::uint32_t>(sizeof(value_type)));
+            hash = hash_combine(hash, requires (Argument argument) { argument.values; } ? 1u : 0u);
+        }
+        return hash;
+    }
+    template <class T>
+    struct SnapshotSignature
+    {};
+    template <class CommandNames, class... Arguments>
+    struct SnapshotSignature<model::Command<CommandNames, Arguments...>> {
+        static constexpr auto value = [] {
+            auto hash = hash_name(longname_of<CommandNames>().value_or(std::string_view{}));
+            ((hash = hash_combine(hash, argument_signature<Arguments>())), ...);
+            return hash;
+        }();
+    };
+    template <StringLiteral Name, model::DefaultCommand def_cmd, class... Commands>
+    struct SnapshotSignature<model::Program<Name, def_cmd, Commands...>> {
+        static constexpr auto value = [] {
+            auto hash = hash_combine(hash_name(Name), std::endian::native == std::endian::little ? 1u : 2u);
+            ((hash = hash_combine(hash, SnapshotSignature<Commands>::value)), ...);
+            return hash;
+        }();
+    };
+
+    template <class OutputIt>
+    struct SnapshotWriter {
+        OutputIt out;
+
+        void write(const void* data, size_t size) {
+            out = std::copy_n(static_cast<const char*>(data), size, out);
+        }
+        template <class T>
+        void write_raw(const T& value) {
+            auto bytes = std::bit_cast<std::array<char, sizeof(T)>>(value);
+            out = std::copy(bytes.begin(), bytes.end(), out);
+        }
+        void write_string(std::string_view str) {
+            write_raw(static_cast<std::uint32_t>(str.size()));
+            write(str.data(), str.size());
+        }
+        template <class T>
+        void write_value(const T& value) {
+            if constexpr (IsLazyValue<T>::value) {
+                write_string(value.raw());
+            } else if constexpr (std::same_as<T, std::string_view>) {
+                write_string(value);
+            } else {
+                static_assert(std::is_trivially_copyable_v<T>, "snapshot values must be string views, lazy or trivially copyable");
+                write_raw(value);
+            }
+        }
+        template <class Argument>
+        void write_argument(const Argument& argument) {
+            if constexpr (model::IsArgumentTyped<Argument, model::ArgumentType::Flag>) {
+                write_raw(static_cast<std::uint64_t>(argument.occurences));
+            } else if constexpr (requires { argument.values; }) {
+                write_raw(static_cast<std::uint32_t>(argument.size()));
+                if constexpr (Argument::is_flat) {
+                    write(argument.values.data(), argument.size() * sizeof(typename Argument::stored_type));
+                } else {
+                    for (const auto& element : argument.values)
+                        write_value(argument.value_of(element));
+                }
+            } else {
+                write_value(*argument.value);
+            }
+        }
+        template <class CommandNames, class... Arguments>
+        void write_command(const model::Command<CommandNames, Arguments...>& command) {
+            std::apply([this](const auto&... arguments) {
+                auto presence = std::array<unsigned char, (sizeof...(Arguments) + 7) / 8>{};
+                size_t i = 0;
+                ((presence[i / 8] |= static_cast<unsigned char>(is_set(arguments) << (i % 8)), ++i), ...);
+                write(presence.data(), presence.size());
+                ((is_set(arguments) ? write_argument(arguments) : void()), ...);
+            }, command.arguments);
+        }
+    };
+
+    /// Reads a snapshot in place: string views point into the snapshot, other values are copied out of it
+    class SnapshotReader {
+        std::string_view m_bytes;
+        std::pmr::memory_resource* m_resource;
+    public:
+        constexpr SnapshotReader(std::string_view bytes, std::pmr::memory_resource* resource) noexcept
+            : m_bytes(bytes), m_resource(resource)
+        {}
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return m_bytes.empty();
+        }
+        [[nodiscard]] auto read(size_t size) noexcept -> std::optional<std::string_view> {
+            if (m_bytes.size() < size) [[unlikely]]
+                return std::nullopt;
+            auto result = m_bytes.substr(0, size);
+            m_bytes.remove_prefix(size);
+            return result;
+        }
+        template <class T>
+        [[nodiscard]] auto read_raw() noexcept -> std::optional<T> {
+            auto bytes = read(sizeof(T));
+            if (!bytes) [[unlikely]]
+                return std::nullopt;
+            auto buffer = std::array<char, sizeof(T)>{};
+            std::copy_n(bytes->data(), sizeof(T), buffer.data());
+            return std::bit_cast<T>(buffer);
+        }
+        [[nodiscard]] auto read_string() noexcept -> std::optional<std::string_view> {
+            auto size = read_raw<std::uint32_t>();
+            if (!size) [[unlikely]]
+                return std::nullopt;
+            return read(*size);
+        }
+        template <class T>
+        [[nodiscard]] auto read_value() noexcept -> std::optional<T> {
+            if constexpr (IsLazyValue<T>::value) {
+                if (auto raw = read_string())
+                    return T(*raw);
+                return std::nullopt;
+            } else if constexpr (std::same_as<T, std::string_view>) {
+                return read_string();
+            } else {
+                static_assert(std::is_trivially_copyable_v<T>, "snapshot values must be string views, lazy or trivially copyable");
+                return read_raw<T>();
+            }
+        }
+        /// Smallest encoded size of a value of type `T`
+        template <class T>
+        static constexpr auto min_value_size() noexcept -> size_t {
+            if constexpr (IsLazyValue<T>::value || std::same_as<T, std::string_view>)
+                return sizeof(std::uint32_t);
+            else
+                return sizeof(T);
+        }
+        template <class Argument>
+        auto read_argument(Argument& argument) -> Expected<void> {
+            auto fail = [](Error::Code code) {
+                return make_unexpected(Error{
+                    .parameter = longname_of<Argument>().value_or(std::string_view{}),
+                    .value = std::nullopt,
+                    .type = Error::Type::Snapshot,
+                    .code = code
+                });
+            };
+            if constexpr (model::IsArgumentTyped<Argument, model::ArgumentType::Flag>) {
+                auto occurences = read_raw<std::uint64_t>();
+                if (!occurences) [[unlikely]]
+                    return fail(Error::Code::SyntaxError);
+                argument.occurences = static_cast<size_t>(*occurences);
+            } else if constexpr (requires { argument.values; }) {
+                auto count = read_raw<std::uint32_t>();
+                // the count is checked against the remaining bytes before anything is reserved for it
+                if (!count || *count > m_bytes.size() / min_value_size<typename Argument::value_type>()) [[unlikely]]
+                    return fail(Error::Code::SyntaxError);
+                if constexpr (requires { argument.values.full(); }) {
+                    if (*count > argument.values.capacity()) [[unlikely]]
+                        return fail(Error::Code::TooManyParameters);
+                } else if (m_resource) {
+                    argument.use_resource(m_resource, *count);
+                } else {
+                    argument.reserve(*count);
+                }
+                if constexpr (Argument::is_flat && !requires { argument.values.full(); }) {
+                    auto bytes = read(*count * sizeof(typename Argument::stored_type));
+                    if (!bytes) [[unlikely]]
+                        return fail(Error::Code::SyntaxError);
+                    argument.values.resize(*count);
+                    std::copy_n(bytes->data(), bytes->size(), reinterpret_cast<char*>(argument.values.data()));
+                } else {
+                    for (std::uint32_t i = 0; i < *count; ++i) {
+                        auto value = read_value<typename Argument::value_type>();
+                        if (!value) [[unlikely]]
+                            return fail(Error::Code::SyntaxError);
+                        argument.values.emplace_back(std::move(*value));
+                    }
+                }
+            } else {
+                auto value = read_value<typename Argument::value_type>();
+                if (!value) [[unlikely]]
+                    return fail(Error::Code::SyntaxError);
+                argument.value = std::move(*value);
+            }
+            return {};
+        }
+        template <class CommandNames, class... Arguments>
+        auto read_command(model::Command<CommandNames, Arguments...>& command) -> Expected<void> {
+            auto presence = read((sizeof...(Arguments) + 7) / 8);
+            if (!presence) [[unlikely]] {
+                return make_unexpected(Error{
+                    .parameter = longname_of<CommandNames>().value_or(std::string_view{}),
+                    .value = std::nullopt,
+                    .type = Error::Type::Snapshot,
+                    .code = Error::Code::SyntaxError
+                });
+            }
+            auto result = Expected<void>{};
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                (void)(((((*presence)[I / 8] >> (I % 8)) & 1 ? (result = read_argument(std::get<I>(command.arguments))) : result) && ...));
+            }(std::index_sequence_for<Arguments...>{});
+            return result;
+        }
+    };
+
+    template <class Model>
+    auto snapshot_error(Error::Code code) -> Error {
+        auto name = std::string_view{};
+        if constexpr (requires { Model::name; })
+            name = Model::name;
+        else
+            name = longname_of<Model>().value_or(std::string_view{});
+        return Error{
+            .parameter = name,
+            .value = std::nullopt,
+            .type = Error::Type::Snapshot,
+            .code = code
+        };
+    }
+}
+
+GLAP_EXPORT namespace glap
+{
+    /// Writes a snapshot of the parsed `command` to `out`, an output iterator of `char`.
+    /// Values must be string views, lazy values (stored raw) or trivially copyable types, copied byte for byte.
+    /// @return the iterator past the last byte written
+    template <class CommandNames, class... Arguments, class OutputIt>
+    auto serialize(const model::Command<CommandNames, Arguments...>& command, OutputIt out) -> OutputIt {
+        auto writer = impl::SnapshotWriter<OutputIt>{out};
+        writer.write(impl::snapshot_magic.data(), impl::snapshot_magic.size());
+        writer.write_raw(impl::snapshot_version);
+        writer.write_raw(impl::SnapshotSignature<model::Command<CommandNames, Arguments...>>::value);
+        writer.write_command(command);
+        return writer.out;
+    }
+    /// Writes a snapshot of the parsed `program` to `out`: its name, the index of its command and the command.
+    template <StringLiteral Name, model::DefaultCommand def_cmd, class... Commands, class OutputIt>
+    auto serialize(const model::Program<Name, def_cmd, Commands...>& program, OutputIt out) -> OutputIt {
+        auto writer = impl::SnapshotWriter<OutputIt>{out};
+        writer.write(impl::snapshot_magic.data(), impl::snapshot_magic.size());
+        writer.write_raw(impl::snapshot_version);
+        writer.write_raw(impl::SnapshotSignature<model::Program<Name, def_cmd, Commands...>>::value);
+        writer.write_string(program.program);
+        writer.write_raw(static_cast<std::uint32_t>(program.command.index()));
+        std::visit([&writer](const auto& command) {
+            writer.write_command(command);
+        }, program.command);
+        return writer.out;
+    }
+    /// Snapshot of a parsed program or command in a string
+    template <class Model>
+    auto serialize(const Model& model) -> std::string {
+        auto result = std::string{};
+        serialize(model, std::back_inserter(result));
+        return result;
+    }
+
+    /// Reads a snapshot written by `serialize` for the same `Model`, in a process of the same build.
+    /// String views (program name, values, raw lazy values) point into `bytes`, which must outlive the result.
+    /// Dynamic lists allocate from `resource` when given, other arguments never allocate.
+    /// Errors have the type `Error::Type::Snapshot`: a truncated or foreign snapshot is a syntax error, an unknown
+    /// command index a bad command, and a list longer than its stack capacity too many parameters.
+    template <class Model>
+    auto deserialize(std::string_view bytes, std::pmr::memory_resource* resource = nullptr) -> Expected<Model> {
+        auto reader = impl::SnapshotReader(bytes, resource);
+        auto magic = reader.read(impl::snapshot_magic.size());
+        auto version = reader.read_raw<std::uint32_t>();
+        auto signature = reader.read_raw<std::uint32_t>();
+        if (magic != impl::snapshot_magic || version != impl::snapshot_version || signature != impl::SnapshotSignature<Model>::value) [[unlikely]]
+            return make_unexpected(impl::snapshot_error<Model>(Error::Code::SyntaxError));
+        auto result = Model{};
+        auto read = Expected<void>{};
+        if constexpr (requires { result.command; }) {
+            auto program = reader.read_string();
+            auto index = reader.read_raw<std::uint32_t>();
+            if (!program || !index) [[unlikely]]
+                return make_unexpected(impl::snapshot_error<Model>(Error::Code::SyntaxError));
+            if (*index >= std::variant_size_v<decltype(result.command)>) [[unlikely]]
+                return make_unexpected(impl::snapshot_error<Model>(Error::Code::BadCommand));
+            result.program = *program;
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                (void)((*index == I ? (read = reader.read_command(result.command.template emplace<I>()), false) : true) && ...);
+            }(std::make_index_sequence<std::variant_size_v<decltype(result.command)>>{});
+        } else {
+            read = reader.read_command(result);
+        }
+        if (!read) [[unlikely]]
+            return make_unexpected(read.error());
+        if (!reader.empty()) [[unlikely]]
+            return make_unexpected(impl::snapshot_error<Model>(Error::Code::SyntaxError));
+        return result;
+    }
+}
\ No newline at end of file
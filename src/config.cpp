@@ -0,0 +1,75 @@
+#ifdef GLAP_MODULE
+module;
+#endif
+
+#if !defined(GLAP_MODULE) || !defined(GLAP_USE_STD_MODULE)
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#endif
+
+#ifndef GLAP_MODULE
+#include <glap/config.h>
+#else
+module glap;
+#endif
+
+namespace glap
+{
+    namespace
+    {
+        constexpr auto trim(std::string_view str) noexcept -> std::string_view {
+            constexpr auto blanks = std::string_view(" \t\r");
+            auto begin = str.find_first_not_of(blanks);
+            if (begin == std::string_view::npos)
+                return {};
+            return str.substr(begin, str.find_last_not_of(blanks) - begin + 1);
+        }
+        constexpr auto unquote(std::string_view str) noexcept -> std::string_view {
+            if (str.size() >= 2 && (str.front() == '"' || str.front() == '\'') && str.back() == str.front())
+                return str.substr(1, str.size() - 2);
+            return str;
+        }
+    }
+
+    auto ConfigFile::open(const std::filesystem::path& path) -> expected<ConfigFile, std::error_code> {
+        auto file = MappedFile::open(path);
+        if (!file) [[unlikely]]
+            return unexpected<std::error_code>(file.error());
+        auto result = parse(file.value()->content());
+        result.m_file = std::move(file.value());
+        return result;
+    }
+    auto ConfigFile::parse(std::string_view content) -> ConfigFile {
+        ConfigFile result;
+        std::string_view section;
+        std::size_t line_number = 0;
+        while (!content.empty()) {
+            auto end = content.find('\n');
+            auto line = trim(content.substr(0, end));
+            content.remove_prefix(end == std::string_view::npos ? content.size() : end + 1);
+            ++line_number;
+            if (line.empty() || line.front() == '#' || line.front() == ';')
+                continue;
+            if (line.front() == '[') {
+                if (line.back() != ']') [[unlikely]]
+                    result.m_entries.push_back(Entry{section, {}, line, line_number});
+                else
+                    section = trim(line.substr(1, line.size() - 2));
+                continue;
+            }
+            auto pos_equal = line.find('=');
+            auto key = trim(line.substr(0, pos_equal));
+            if (key.empty()) [[unlikely]] {
+                result.m_entries.push_back(Entry{section, {}, line, line_number});
+                continue;
+            }
+            auto value = pos_equal == std::string_view::npos
+                ? std::optional<std::string_view>()
+                : unquote(trim(line.substr(pos_equal + 1)));
+            result.m_entries.push_back(Entry{section, key, value, line_number});
+        }
+        return result;
+    }
+}
\ No newline at end of file
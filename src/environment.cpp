@@ -0,0 +1,36 @@
+#ifdef GLAP_MODULE
+module;
+#endif
+
+#if defined(_WIN32)
+#include <stdlib.h>
+#elif defined(__APPLE__)
+#include <crt_externs.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifndef GLAP_MODULE
+#include <glap/environment.h>
+#else
+module glap;
+#endif
+
+#if !defined(_WIN32) && !defined(__APPLE__) && !defined(__USE_GNU)
+// <unistd.h> declares it in GNU mode only. Declared after the module declaration, since a global module fragment only
+// holds preprocessor inclusions.
+extern "C" char** environ;
+#endif
+
+namespace glap::impl
+{
+    auto environment() noexcept -> const char* const* {
+#if defined(_WIN32)
+        return _environ;
+#elif defined(__APPLE__)
+        return *_NSGetEnviron();
+#else
+        return environ;
+#endif
+    }
+}
\ No newline at end of file
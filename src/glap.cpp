@@ -1,14 +1,18 @@
-#ifndef GLAP_MODULE
+#ifdef GLAP_MODULE
+module;
+#endif
+
+#if !defined(GLAP_MODULE) || !defined(GLAP_USE_STD_MODULE)
 #include <string_view>
 #include <array>
+#endif
+
+#ifndef GLAP_MODULE
 #include <glap/core/fmt.h>
 #include <glap/core/error.h>
+#include <glap/core/suggest.h>
 #else
 module glap;
-
-#ifndef GLAP_USE_STD_MODULE
-import <array>;
-#endif
 #endif
 
 namespace glap 
@@ -21,6 +25,9 @@ namespace glap
             " (type: input)",
             "",
             " (type: unknown)",
+            " (type: environment)",
+            " (type: config)",
+            " (type: snapshot)",
         };
         auto constexpr codes_text = std::array{
             "no parameter",
@@ -39,6 +46,18 @@ namespace glap
         if (this->value) {
             value = glap::format(" (value: \"{}\")", *this->value);
         }
-        return glap::format("\"{}\"{}{} : {}", this->parameter, value, types[static_cast<std::size_t>(this->type)], codes_text[static_cast<std::size_t>(this->code)]);
+        auto suggestions = std::string{};
+        for (auto suggestion : this->suggestions()) {
+            if (suggestion.empty())
+                break;
+            suggestions += glap::format("{}\"{}\"", suggestions.empty() ? " (did you mean " : ", ", suggestion);
+        }
+        if (!suggestions.empty()) {
+            suggestions += "?)";
+        }
+        return glap::format("\"{}\"{}{} : {}{}", this->parameter, value, types[static_cast<std::size_t>(this->type)], codes_text[static_cast<std::size_t>(this->code)], suggestions);
+    }
+    auto Error::suggestions() const -> Suggestions {
+        return impl::suggest(this->parameter, this->candidates);
     }
 }
\ No newline at end of file
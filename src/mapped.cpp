@@ -0,0 +1,167 @@
+#ifdef GLAP_MODULE
+module;
+#endif
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if !defined(GLAP_MODULE) || !defined(GLAP_USE_STD_MODULE)
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#endif
+
+#ifndef GLAP_MODULE
+#include <glap/mapped.h>
+#else
+module glap;
+#endif
+
+namespace glap
+{
+#ifdef _WIN32
+    auto MappedFile::open(const std::filesystem::path& path) -> expected<std::shared_ptr<const MappedFile>, std::error_code> {
+        auto last_error = [] {
+            return unexpected<std::error_code>(std::error_code(static_cast<int>(::GetLastError()), std::system_category()));
+        };
+        auto file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return last_error();
+        LARGE_INTEGER size;
+        if (!::GetFileSizeEx(file, &size)) {
+            auto error = last_error();
+            ::CloseHandle(file);
+            return error;
+        }
+        auto result = std::shared_ptr<MappedFile>(new MappedFile());
+        if (::GetFileType(file) != FILE_TYPE_DISK) {
+            char chunk[4096];
+            DWORD read = 0;
+            while (::ReadFile(file, chunk, sizeof(chunk), &read, nullptr) && read > 0)
+                result->m_buffer.append(chunk, read);
+            auto error = ::GetLastError();
+            ::CloseHandle(file);
+            if (error != ERROR_SUCCESS && error != ERROR_BROKEN_PIPE && error != ERROR_HANDLE_EOF)
+                return unexpected<std::error_code>(std::error_code(static_cast<int>(error), std::system_category()));
+            result->m_data = result->m_buffer.data();
+            result->m_size = result->m_buffer.size();
+            return result;
+        }
+        if (size.QuadPart == 0) {
+            ::CloseHandle(file);
+            return result;
+        }
+        auto mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        ::CloseHandle(file);
+        if (!mapping)
+            return last_error();
+        auto data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        ::CloseHandle(mapping);
+        if (!data)
+            return last_error();
+        result->m_data = static_cast<const char*>(data);
+        result->m_size = static_cast<std::size_t>(size.QuadPart);
+        return result;
+    }
+    MappedFile::~MappedFile() {
+        if (m_data && m_data != m_buffer.data())
+            ::UnmapViewOfFile(m_data);
+    }
+#else
+    auto MappedFile::open(const std::filesystem::path& path) -> expected<std::shared_ptr<const MappedFile>, std::error_code> {
+        auto last_error = [] {
+            return unexpected<std::error_code>(std::error_code(errno, std::system_category()));
+        };
+        auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return last_error();
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            auto error = last_error();
+            ::close(fd);
+            return error;
+        }
+        auto result = std::shared_ptr<MappedFile>(new MappedFile());
+        if (!S_ISREG(st.st_mode)) {
+            char chunk[4096];
+            for (;;) {
+                auto read = ::read(fd, chunk, sizeof(chunk));
+                if (read < 0 && errno == EINTR)
+                    continue;
+                if (read < 0) {
+                    auto error = last_error();
+                    ::close(fd);
+                    return error;
+                }
+                if (read == 0)
+                    break;
+                result->m_buffer.append(chunk, static_cast<std::size_t>(read));
+            }
+            ::close(fd);
+            result->m_data = result->m_buffer.data();
+            result->m_size = result->m_buffer.size();
+            return result;
+        }
+        if (st.st_size == 0) {
+            ::close(fd);
+            return result;
+        }
+        auto data = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        auto error = last_error();
+        ::close(fd);
+        if (data == MAP_FAILED)
+            return error;
+        result->m_data = static_cast<const char*>(data);
+        result->m_size = static_cast<std::size_t>(st.st_size);
+        return result;
+    }
+    MappedFile::~MappedFile() {
+        if (m_data && m_data != m_buffer.data())
+            ::munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+
+    auto MappedArguments::append_file(const std::filesystem::path& path) -> expected<void, std::error_code> {
+        auto file = MappedFile::open(path);
+        if (!file) [[unlikely]]
+            return unexpected<std::error_code>(file.error());
+        auto content = file.value()->content();
+        if (content.empty())
+            return {};
+        m_files.push_back(std::move(file.value()));
+
+        auto nul_delimited = std::memchr(content.data(), '\0', content.size()) != nullptr;
+        auto delimiter = nul_delimited ? '\0' : '\n';
+        while (!content.empty()) {
+            auto end = static_cast<const char*>(std::memchr(content.data(), delimiter, content.size()));
+            auto length = end ? static_cast<std::size_t>(end - content.data()) : content.size();
+            auto arg = content.substr(0, length);
+            content.remove_prefix(end ? length + 1 : length);
+            if (nul_delimited) {
+                m_arguments.push_back(arg);
+            } else {
+                if (arg.ends_with('\r'))
+                    arg.remove_suffix(1);
+                if (!arg.empty())
+                    m_arguments.push_back(arg);
+            }
+        }
+        return {};
+    }
+}
\ No newline at end of file
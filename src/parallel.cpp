@@ -0,0 +1,79 @@
+#ifdef GLAP_MODULE
+module;
+#endif
+
+#if !defined(GLAP_MODULE) || !defined(GLAP_USE_STD_MODULE)
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#endif
+
+#ifndef GLAP_MODULE
+#include <glap/core/parallel.h>
+#else
+module glap;
+#endif
+
+namespace glap
+{
+    ThreadPool::ThreadPool(unsigned threads) {
+        if (threads == 0)
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+        m_workers.reserve(threads - 1);
+        for (unsigned i = 1; i < threads; ++i)
+            m_workers.emplace_back([this] { worker_loop(); });
+    }
+    ThreadPool::~ThreadPool() {
+        {
+            std::scoped_lock lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        m_workers.clear();
+    }
+    void ThreadPool::run(std::size_t count, std::size_t chunk, Job job, void* context) {
+        if (count == 0)
+            return;
+        if (chunk == 0)
+            chunk = std::max<std::size_t>(1, count / (size() * 8));
+        std::scoped_lock submit(m_submit);
+        {
+            std::scoped_lock lock(m_mutex);
+            m_job = job;
+            m_context = context;
+            m_count = count;
+            m_chunk = chunk;
+            m_next.store(0, std::memory_order_relaxed);
+            m_active = m_workers.size();
+            ++m_generation;
+        }
+        m_wake.notify_all();
+        run_chunks();
+        std::unique_lock lock(m_mutex);
+        m_done.wait(lock, [this] { return m_active == 0; });
+    }
+    void ThreadPool::run_chunks() noexcept {
+        for (;;) {
+            auto begin = m_next.fetch_add(m_chunk, std::memory_order_relaxed);
+            if (begin >= m_count)
+                return;
+            m_job(m_context, begin, std::min(begin + m_chunk, m_count));
+        }
+    }
+    void ThreadPool::worker_loop() noexcept {
+        std::size_t generation = 0;
+        for (;;) {
+            {
+                std::unique_lock lock(m_mutex);
+                m_wake.wait(lock, [&] { return m_stop || m_generation != generation; });
+                if (m_stop)
+                    return;
+                generation = m_generation;
+            }
+            run_chunks();
+            std::scoped_lock lock(m_mutex);
+            if (--m_active == 0)
+                m_done.notify_one();
+        }
+    }
+}
@@ -32,7 +32,7 @@ namespace format {
 
 #ifdef GLAP_USE_FMT
 #include <fmt/format.h>
-using namespace format = fmt;
+namespace format = fmt;
 #else
 #include <format>
 #include <iostream>
@@ -64,7 +64,7 @@ void print(const T& value) {
     } else if constexpr (requires { value.values; }) { // Container based
         format::print("[ ");
         for (const auto& v : value.values) {
-            format::print("\"{}\" ", v.value.value());
+            format::print("\"{}\" ", value.value_of(v));
         }
         format::print("]");
     } else if constexpr (requires { value.occurences; }) { // Flag
@@ -142,6 +142,35 @@ using command2_t = glap::model::Command<
 
 using program_t = glap::model::Program<"myprogram", glap::model::DefaultCommand::FirstDefined, command1_t, command2_t>;
 
+using help_command1_t = glap::help::model::Command<
+    "command1",
+    glap::help::model::Description<"first command">,
+    glap::help::model::Argument<"flag", glap::help::model::Description<"a flag">>,
+    glap::help::model::Argument<"verbose", glap::help::model::Description<"verbose output">>,
+    glap::help::model::Argument<"help", glap::help::model::Description<"prints this help">>,
+    glap::help::model::Argument<"INPUTS", glap::help::model::Description<"input values">>
+>;
+using help_command2_t = glap::help::model::Command<
+    "command2",
+    glap::help::model::Description<"second command">,
+    glap::help::model::Argument<"to_int", glap::help::model::Description<"an integer">>,
+    glap::help::model::Argument<"help", glap::help::model::Description<"prints this help">>
+>;
+using help_program_t = glap::help::model::Program<
+    "myprogram",
+    glap::help::model::FullDescription<"glap example", "Parses and prints the command line">,
+    help_command1_t,
+    help_command2_t
+>;
+
+template <class Help, class Command>
+bool print_help(const Command& command) {
+    if (command.template get_argument<"help">().occurences == 0)
+        return false;
+    format::print("{}\n", glap::help_text<Help, Command>);
+    return true;
+}
+
 int main(int argc, char** argv)
 {
     using namespace glap::model;
@@ -152,9 +181,13 @@ int main(int argc, char** argv)
 
     if (result) {
         auto& v = *result;
+        if (auto command = std::get_if<command1_t>(&v.command); command && print_help<help_command1_t>(*command))
+            return 0;
+        if (auto command = std::get_if<command2_t>(&v.command); command && print_help<help_command2_t>(*command))
+            return 0;
         print(v);
     } else {
-        format::print("{}\n", result.error().to_string());
+        format::print("{}\n\n{}\n", result.error().to_string(), glap::help_text<help_program_t, program_t>);
         return 1;
     }
     return 0;
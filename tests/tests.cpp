@@ -9,16 +9,37 @@ import std; // expected exists on c++23 no need to fallback
 #endif
 import <gtest/gtest.h>;
 #else
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <charconv>
+#include <cstring>
+#include <glap/core/utf8.h>
+#include <memory_resource>
 #include <glap/parser.h>
 #include <glap/model.h>
+#include <glap/incremental.h>
+#include <glap/mapped.h>
+#include <glap/environment.h>
+#include <glap/config.h>
+#include <glap/batch.h>
+#include <glap/help.h>
+#include <glap/completion.h>
+#include <glap/serialize.h>
+#include <filesystem>
+#include <fstream>
 #include <optional>
+#include <ranges>
 #include <string>
 #include <string_view>
 #include <concepts>
 #include <gtest/gtest.h>
+#include <thread>
 #include <variant>
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/stat.h>
+#endif
 #endif
 
 
@@ -451,6 +472,317 @@ TEST(glap_resolver, integer_parameter_bad_resolution) {
     auto error = result.error();
     ASSERT_EQ(error.error.code, glap::Error::Code::BadResolution);
 }
+using CommandNumbers = glap::model::Command<glap::Names<"numbers">,
+    glap::model::Parameters<glap::Names<"ints", 'i'>, glap::discard, from_chars<int>>,
+    glap::model::Parameters<glap::Names<"stack_ints", 's'>, 2, from_chars<int>>,
+    glap::model::Inputs<glap::discard, from_chars<double>>
+>;
+static_assert(std::same_as<glap::model::Parameters<glap::Names<"ints">, glap::discard, from_chars<int>>::container_type, std::pmr::vector<int>>);
+static_assert(std::same_as<glap::model::Parameters<glap::Names<"ints">, 2, from_chars<int>>::container_type, glap::StackVector<int, 2>>);
+static_assert(!glap::model::Parameters<glap::Names<"points">, glap::discard, from_chars<Point>>::is_flat);
+static_assert(!glap::model::Inputs<>::is_flat);
+TEST(glap_resolver, arithmetic_lists_are_contiguous) {
+    auto result = glap::parser<CommandNumbers>(std::array{"-i"sv, "1"sv, "--ints=-2"sv, "-s"sv, "3"sv, "0.5"sv, "-i"sv, "4"sv, "1e3"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    auto ints = result.value().get_argument<"ints">().span();
+    ASSERT_EQ(ints.size(), 3);
+    EXPECT_EQ(ints[0], 1);
+    EXPECT_EQ(ints[1], -2);
+    EXPECT_EQ(ints[2], 4);
+    EXPECT_EQ(result.value().get_argument<"ints">()[2], 4);
+    ASSERT_EQ(result.value().get_argument<"stack_ints">().span().size(), 1);
+    EXPECT_EQ(result.value().get_argument<"stack_ints">().get<0>(), 3);
+    auto inputs = result.value().get_inputs().span();
+    ASSERT_EQ(inputs.size(), 2);
+    EXPECT_EQ(inputs[0], 0.5);
+    EXPECT_EQ(inputs[1], 1000.0);
+
+    auto overflow = glap::parser<CommandNumbers>(std::array{"-s"sv, "1"sv, "-s"sv, "2"sv, "-s"sv, "3"sv});
+    ASSERT_FALSE(overflow) << "stack list overflowed";
+    EXPECT_EQ(overflow.error().error.code, glap::Error::Code::TooManyParameters);
+}
+#pragma endregion
+
+#pragma region Glap lazy tests
+static int lazy_resolutions = 0;
+glap::expected<int, glap::Discard> counted_int(std::string_view v) {
+    ++lazy_resolutions;
+    return from_chars<int>(v);
+}
+using CommandLazy = glap::model::Command<glap::Names<"lazy">,
+    glap::model::Parameter<glap::Names<"int", 'i'>, glap::lazy<counted_int>>,
+    glap::model::Flag<glap::Names<"help", 'h'>>,
+    glap::model::Inputs<glap::discard, glap::lazy<counted_int>>
+>;
+using ProgramLazy = glap::model::Program<"lazy", glap::model::DefaultCommand::FirstDefined, CommandLazy>;
+
+TEST(glap_lazy, deferred_resolution) {
+    lazy_resolutions = 0;
+    auto result = glap::parser<ProgramLazy>(std::array{"glap"sv, "--int=12"sv, "-h"sv, "3"sv, "4"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    ASSERT_EQ(lazy_resolutions, 0) << "Lazy values resolved during parsing";
+    auto command = std::get<CommandLazy>(result.value().command);
+    auto& param = command.get_argument<"int">().value;
+    ASSERT_TRUE(param);
+    ASSERT_EQ(param->raw(), "12"sv);
+    ASSERT_EQ(param->get(), 12);
+    ASSERT_EQ(param->get(), 12);
+    ASSERT_EQ(lazy_resolutions, 1) << "Lazy value not memoized";
+    auto& inputs = command.get_inputs();
+    ASSERT_EQ(inputs.size(), 2);
+    ASSERT_EQ(inputs[1]->get(), 4);
+    ASSERT_EQ(lazy_resolutions, 2);
+}
+TEST(glap_lazy, validate_all) {
+    lazy_resolutions = 0;
+    auto result = glap::parser<ProgramLazy>(std::array{"glap"sv, "--int=12"sv, "3"sv, "nan"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    auto validated = glap::validate_all(result.value());
+    ASSERT_FALSE(validated) << "Bad lazy value accepted";
+    ASSERT_EQ(validated.error().code, glap::Error::Code::BadResolution);
+    ASSERT_EQ(validated.error().type, glap::Error::Type::Input);
+    ASSERT_EQ(validated.error().value, "nan"sv);
+    ASSERT_EQ(lazy_resolutions, 3);
+    ASSERT_FALSE(glap::validate_all(result.value()));
+    ASSERT_EQ(lazy_resolutions, 3) << "Lazy values resolved twice";
+}
+#pragma endregion
+
+#pragma region Glap name lookup tests
+static_assert(glap::impl::longname_table<>.find("flag") == glap::impl::npos_index);
+static_assert(glap::impl::longname_table<glap::Names<"flag">, glap::model::Input<>, glap::Names<"param">>.find("param") == 2);
+static_assert(glap::impl::longname_table<glap::Names<"flag">, glap::model::Input<>, glap::Names<"param">>.find("para") == glap::impl::npos_index);
+static_assert(glap::impl::shortname_table<glap::Names<"flag", U'é'>, glap::model::Input<>, glap::Names<"param", 'p'>>.find('p') == 2);
+static_assert(glap::impl::shortname_table<glap::Names<"flag", U'é'>, glap::model::Input<>, glap::Names<"param", 'p'>>.find(U'é') == 0);
+static_assert(glap::impl::shortname_table<glap::Names<"flag", U'é'>, glap::model::Input<>, glap::Names<"param", 'p'>>.find('f') == glap::impl::npos_index);
+static_assert(!glap::impl::NameChecker<glap::Names<"flag", 'f'>, glap::model::Input<>, glap::model::Input<>, glap::Names<"param">>::has_duplicate_longname);
+static_assert(!glap::impl::NameChecker<glap::Names<"flag", 'f'>, glap::model::Input<>, glap::Names<"param">>::has_duplicate_shortname);
+static_assert(glap::impl::NameChecker<glap::Names<"param", 'f'>, glap::model::Input<>, glap::Names<"flag">, glap::Names<"param">>::has_duplicate_longname);
+static_assert(glap::impl::NameChecker<glap::Names<"flag", U'é'>, glap::model::Input<>, glap::Names<"param", U'é'>>::has_duplicate_shortname);
+
+using CommandUnicode = glap::model::Command<glap::Names<"unicode">,
+    glap::model::Flag<glap::Names<"verbose", U'é'>>,
+    glap::model::Flag<glap::Names<"quiet", 'q'>>,
+    glap::model::Parameter<glap::Names<"name", U'🔥'>>
+>;
+constexpr auto tests_unicode = glap::parser<CommandUnicode>;
+
+TEST(glap_lookup, unicode_short_cluster) {
+    auto result = tests_unicode(std::array{"-é🔥qé"sv, "value"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    EXPECT_EQ(result.value().get_argument<"verbose">().occurences, 2);
+    EXPECT_EQ(result.value().get_argument<"quiet">().occurences, 1);
+    EXPECT_EQ(result.value().get_argument<"name">().value, "value");
+}
+TEST(glap_lookup, unicode_short_missing_value) {
+    auto result = tests_unicode(std::array{"-q🔥"sv});
+    ASSERT_FALSE(result) << "Parser successed when it should not";
+    ASSERT_EQ(result.error().error.code, glap::Error::Code::MissingValue);
+}
+using ProgramUnicode = glap::model::Program<"unicode", glap::model::DefaultCommand::None,
+    glap::model::Command<glap::Names<"first", 'f'>>,
+    glap::model::Command<glap::Names<"second", U'🔥'>>
+>;
+constexpr auto tests_program_unicode = glap::parser<ProgramUnicode>;
+
+TEST(glap_lookup, unicode_command_short_name) {
+    auto result = tests_program_unicode(std::array{"glap"sv, "🔥"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    ASSERT_EQ(result.value().command.index(), 1) << "Wrong command index";
+}
+TEST(glap_lookup, command_multi_codepoint_name) {
+    auto result = tests_program_unicode(std::array{"glap"sv, "🔥f"sv});
+    ASSERT_FALSE(result) << "Parser successed when it should not";
+    ASSERT_EQ(result.error().error.code, glap::Error::Code::BadCommand);
+}
+TEST(glap_lookup, command_empty_name) {
+    auto result = tests_program_unicode(std::array{"glap"sv, ""sv});
+    ASSERT_FALSE(result) << "Parser successed when it should not";
+    ASSERT_EQ(result.error().error.code, glap::Error::Code::BadCommand);
+}
+TEST(glap_lookup, flag_with_value) {
+    auto result = tests_parser(std::array{"glap"sv, "command1"sv, "--flag=value"sv});
+    ASSERT_FALSE(result) << "Parser successed when it should not";
+    auto error = result.error();
+    ASSERT_EQ(error.error.code, glap::Error::Code::UnknownArgument);
+}
+TEST(glap_lookup, parameter_without_value) {
+    auto result = tests_parser(std::array{"glap"sv, "command1"sv, "--param"sv});
+    ASSERT_FALSE(result) << "Parser successed when it should not";
+    auto error = result.error();
+    ASSERT_EQ(error.error.code, glap::Error::Code::UnknownArgument);
+}
+#pragma endregion
+
+#pragma region Glap suggestion tests
+static_assert(glap::impl::EditDistance("kitten")("sitting") == 3);
+static_assert(glap::impl::EditDistance("flag")("fag") == 1);
+static_assert(glap::impl::EditDistance("")("abc") == 3);
+TEST(glap_suggestion, edit_distance) {
+    auto levenshtein = [](std::string_view a, std::string_view b) {
+        auto row = std::vector<size_t>(b.size() + 1);
+        for (size_t j = 0; j <= b.size(); ++j)
+            row[j] = j;
+        for (size_t i = 1; i <= a.size(); ++i) {
+            auto diagonal = row[0];
+            row[0] = i;
+            for (size_t j = 1; j <= b.size(); ++j) {
+                auto up = row[j];
+                row[j] = std::min({row[j] + 1, row[j - 1] + 1, diagonal + (a[i - 1] == b[j - 1] ? 0 : 1)});
+                diagonal = up;
+            }
+        }
+        return row[b.size()];
+    };
+    auto words = std::array{""sv, "a"sv, "flag"sv, "fgal"sv, "params"sv, "stack_args"sv, "h\u00e9llo \U0001F525"sv,
+        "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyzabcdefghijkl"sv, "bcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyzabcdefghijklm"sv};
+    for (auto pattern : words) {
+        auto distance = glap::impl::EditDistance(pattern);
+        for (auto text : words)
+            EXPECT_EQ(distance(text), levenshtein(pattern, text)) << pattern << " / " << text;
+    }
+}
+TEST(glap_suggestion, unknown_argument) {
+    auto result = tests_parser(std::array{"glap"sv, "command1"sv, "--fag"sv});
+    ASSERT_FALSE(result) << "Parser successed when it should not";
+    auto error = result.error().error;
+    ASSERT_EQ(error.code, glap::Error::Code::UnknownArgument);
+    EXPECT_EQ(error.suggestions()[0], "flag");
+    EXPECT_EQ(error.suggestions()[1], "");
+    EXPECT_EQ(error.to_string(), "\"fag\" (type: unknown) : unknown argument (did you mean \"flag\"?)");
+}
+TEST(glap_suggestion, bad_command) {
+    auto result = tests_parser_no_default(std::array{"glap"sv, "comand2"sv});
+    ASSERT_FALSE(result) << "Parser successed when it should not";
+    auto error = result.error().error;
+    ASSERT_EQ(error.code, glap::Error::Code::BadCommand);
+    EXPECT_EQ(error.suggestions(), (glap::Suggestions{"command2", "command1", "command3"}));
+}
+TEST(glap_suggestion, no_suggestion) {
+    auto result = tests_parser(std::array{"glap"sv, "command1"sv, "--xyz"sv});
+    ASSERT_FALSE(result) << "Parser successed when it should not";
+    EXPECT_EQ(result.error().error.suggestions()[0], "");
+    EXPECT_EQ(result.error().error.to_string(), "\"xyz\" (type: unknown) : unknown argument");
+}
+TEST(glap_suggestion, known_name_not_suggested) {
+    static constexpr auto names = std::array{"flag"sv, "param"sv};
+    EXPECT_EQ(glap::impl::suggest("param", names)[0], "");
+    for (auto arg : {"--param"sv, "--flag=x"sv}) {
+        auto result = tests_parser(std::array{"glap"sv, "command1"sv, arg, "value"sv});
+        ASSERT_FALSE(result) << "Parser successed when it should not: " << arg;
+        EXPECT_EQ(result.error().error.code, glap::Error::Code::UnknownArgument);
+        EXPECT_EQ(result.error().error.suggestions()[0], "") << arg;
+        EXPECT_EQ(result.error().error.to_string().find("did you mean"), std::string::npos) << arg;
+    }
+}
+#pragma endregion
+
+#pragma region Glap stack vector tests
+static_assert(std::random_access_iterator<glap::StackVector<std::string, 4>::iterator>);
+static_assert(std::random_access_iterator<glap::StackVector<std::string, 4>::const_iterator>);
+static_assert([] {
+    glap::StackVector<int, 4> values;
+    values.push_back(1);
+    values.push_back(2);
+    values.emplace_back(3);
+    auto copy = values;
+    copy.remove(0);
+    int sum = 0;
+    for (auto v : copy)
+        sum += v;
+    return sum == 5 && copy.size() == 2 && copy[0] == 3 && values.size() == 3;
+}());
+struct Counted {
+    static inline int alive = 0;
+    Counted() { ++alive; }
+    Counted(const Counted&) { ++alive; }
+    ~Counted() { --alive; }
+};
+TEST(glap_stack_vector, lazy_construction) {
+    {
+        glap::StackVector<Counted, 8> values;
+        EXPECT_EQ(Counted::alive, 0) << "unused slots must not be constructed";
+        values.emplace_back();
+        values.emplace_back();
+        EXPECT_EQ(Counted::alive, 2);
+        auto copy = values;
+        EXPECT_EQ(Counted::alive, 4);
+        copy.pop_back();
+        EXPECT_EQ(Counted::alive, 3);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+}
+TEST(glap_stack_vector, bounds) {
+    glap::StackVector<std::string, 2> values;
+    EXPECT_TRUE(values.push_back("a"));
+    EXPECT_TRUE(values.push_back("b"));
+    EXPECT_FALSE(values.push_back("c")) << "push_back on a full vector must fail";
+    EXPECT_EQ(values.size(), 2);
+    EXPECT_EQ(std::distance(values.begin(), values.end()), 2);
+    EXPECT_EQ(values.end()[-1], "b");
+}
+TEST(glap_stack_vector, fixed_arity_parameters) {
+    auto result = tests_parser(std::array{"glap"sv, "command2"sv, "-cc"sv, "v1"sv, "v2"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    const auto& values = std::get<Command2>(result.value().command).get_argument<"stack_args">().values;
+    ASSERT_EQ(values.size(), 2);
+    EXPECT_EQ(values.front().value, "v1"sv);
+    EXPECT_EQ(values.back().value, "v2"sv);
+}
+#pragma endregion
+
+#pragma region Glap memory resource tests
+struct CountingResource : std::pmr::memory_resource {
+    size_t allocations = 0;
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+TEST(glap_resource, containers_use_resource) {
+    CountingResource resource;
+    auto result = tests_parser(std::array{"glap"sv, "command2"sv, "-bbb"sv, "v1"sv, "v2"sv, "v3"sv, "i1"sv, "i2"sv, "-c"sv, "s1"sv}, &resource);
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    const auto& command = std::get<Command2>(result.value().command);
+    const auto& params = command.get_argument<"params">().values;
+    const auto& inputs = command.get_inputs().values;
+    EXPECT_EQ(params.get_allocator().resource(), &resource);
+    EXPECT_EQ(inputs.get_allocator().resource(), &resource);
+    EXPECT_EQ(params.size(), 3);
+    EXPECT_EQ(inputs.size(), 2);
+    EXPECT_EQ(resource.allocations, 2) << "one allocation per dynamic container expected";
+}
+TEST(glap_resource, presize) {
+    auto args = std::array{"glap"sv, "command2"sv, "-bab"sv, "v1"sv, "hello"sv, "v2"sv, "i1"sv, "--params=v3"sv, "--flag"sv, "i2"sv, "-c"sv, "s1"sv};
+    auto result = tests_parser(args, glap::ParseOptions{.presize = true});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    const auto& command = std::get<Command2>(result.value().command);
+    EXPECT_EQ(command.get_argument<"params">().values.size(), 3);
+    EXPECT_EQ(command.get_argument<"params">().values.capacity(), 3);
+    EXPECT_EQ(command.get_inputs().values.size(), 2);
+    EXPECT_EQ(command.get_inputs().values.capacity(), 2);
+
+    CountingResource resource;
+    result = tests_parser(args, glap::ParseOptions{.resource = &resource, .presize = true});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    EXPECT_EQ(std::get<Command2>(result.value().command).get_inputs().values.capacity(), 2);
+    EXPECT_EQ(resource.allocations, 2);
+}
+TEST(glap_resource, command_parser) {
+    CountingResource resource;
+    auto args = std::array{"input1"sv, "input2"sv, "input3"sv};
+    auto result = tests_no_command(args, glap::ParseOptions{.resource = &resource});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    EXPECT_EQ(result.value().get_inputs().size(), 3);
+    EXPECT_EQ(resource.allocations, 1);
+}
 #pragma endregion
 
 #pragma region Glap combined arguments tests
@@ -508,4 +840,706 @@ TEST(glap_combined, parameters_default_command) {
     ASSERT_EQ(command1.get_argument<"param">().value, "value");
     ASSERT_EQ(command1.get_argument<"flag">().occurences, 1);
 }
+#pragma endregion
+
+#pragma region Glap incremental tests
+using ProgramIncrementalUnicode = glap::model::Program<"unicode", glap::model::DefaultCommand::FirstDefined, CommandUnicode>;
+
+template <class Program, class Args>
+void check_incremental(const Args& args) {
+    auto expected = glap::parser<Program>(args);
+    for (size_t batch = 1; batch <= args.size() + 1; ++batch) {
+        auto parser = glap::IncrementalParser<Program>{};
+        for (size_t i = 0; i < args.size(); i += batch)
+            parser.feed(std::span(args).subspan(i, std::min(batch, args.size() - i)));
+        auto result = parser.finish();
+        ASSERT_EQ(result.has_value(), expected.has_value()) << "batch of " << batch;
+        if (!expected) {
+            EXPECT_EQ(result.error().error.code, expected.error().error.code) << "batch of " << batch;
+            EXPECT_EQ(result.error().position, expected.error().position) << "batch of " << batch;
+        } else {
+            EXPECT_EQ(result.value().program, expected.value().program);
+            EXPECT_EQ(result.value().command.index(), expected.value().command.index()) << "batch of " << batch;
+        }
+    }
+}
+TEST(glap_incremental, same_as_parser) {
+    check_incremental<ProgramTest>(std::array{"glap"sv});
+    check_incremental<ProgramTest>(std::array{"glap"sv, "--flag"sv, "-c"sv, "value"sv, "input"sv});
+    check_incremental<ProgramTest>(std::array{"glap"sv, "command2"sv, "-abc"sv, "hello"sv, "v1"sv, "v2"sv, "-f"sv});
+    check_incremental<ProgramTest>(std::array{"glap"sv, "command2"sv, "-fab"sv, "hello"sv});
+    check_incremental<ProgramTest>(std::array{"glap"sv, "command3"sv, "--int=12"sv, "--int=13"sv});
+    check_incremental<ProgramTest>(std::array{"glap"sv, "unknown"sv, "--flag"sv});
+    check_incremental<ProgramTest>(std::array{"glap"sv, "command1"sv, "-z"sv});
+    check_incremental<ProgramTestNoDefault>(std::array{"glap"sv, "-f"sv});
+    check_incremental<ProgramTestNoDefault>(std::array{"glap"sv});
+    check_incremental<ProgramIncrementalUnicode>(std::array{"glap"sv, "-é🔥qé"sv, "value"sv, "-q"sv});
+    check_incremental<ProgramIncrementalUnicode>(std::array{"glap"sv, "unicode"sv, "-q🔥"sv});
+}
+TEST(glap_incremental, pending_short_parameter) {
+    auto parser = glap::IncrementalParser<ProgramTest>{};
+    parser.feed(std::array{"glap"sv, "command2"sv, "-ab"sv});
+    parser.feed("hello"sv);
+    parser.feed("v1"sv);
+    auto result = parser.finish();
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    auto command = std::get<Command2>(result.value().command);
+    ASSERT_EQ(command.get_argument<"param">().value, "hello"sv);
+    ASSERT_EQ(command.get_argument<"params">().size(), 1);
+    ASSERT_EQ(command.get_argument<"params">()[0], "v1"sv);
+}
+TEST(glap_incremental, empty) {
+    auto result = glap::IncrementalParser<ProgramTest>{}.finish();
+    ASSERT_FALSE(result);
+    ASSERT_EQ(result.error().error.code, glap::Error::Code::NoParameter);
+}
+#pragma endregion
+
+#pragma region Glap mapped arguments tests
+static std::filesystem::path write_arguments_file(std::string_view name, std::string_view content) {
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream(path, std::ios::binary).write(content.data(), static_cast<std::streamsize>(content.size()));
+    return path;
+}
+TEST(glap_mapped, nul_delimited) {
+    auto path = write_arguments_file("glap_nul_args", "glap\0command2\0--params=\0-b\0v2\0"sv);
+    {
+        auto args = glap::MappedArguments::open(path);
+        ASSERT_TRUE(args) << args.error().message();
+        ASSERT_EQ(args->size(), 5);
+        EXPECT_EQ((*args)[2], "--params="sv);
+        EXPECT_EQ((*args)[4], "v2"sv);
+        auto result = tests_parser(*args);
+        ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+        auto command = std::get<Command2>(result.value().command);
+        ASSERT_EQ(command.get_argument<"params">().size(), 2);
+        EXPECT_EQ(command.get_argument<"params">()[0], ""sv);
+        EXPECT_EQ(result.value().storage.size(), 1);
+    }
+    std::filesystem::remove(path);
+}
+#ifndef _WIN32
+TEST(glap_mapped, nul_delimited_pipe) {
+    auto path = std::filesystem::temp_directory_path() / "glap_nul_fifo";
+    std::filesystem::remove(path);
+    ASSERT_EQ(::mkfifo(path.c_str(), 0600), 0) << std::strerror(errno);
+    auto writer = std::thread([&path] {
+        std::ofstream(path, std::ios::binary) << "glap"sv << '\0' << "command2"sv << '\0' << "-b"sv << '\0' << "v"sv << '\0';
+    });
+    auto args = glap::MappedArguments::open(path);
+    writer.join();
+    std::filesystem::remove(path);
+    ASSERT_TRUE(args) << args.error().message();
+    ASSERT_EQ(args->size(), 4) << "pipe read as empty";
+    auto result = tests_parser(*args);
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    EXPECT_EQ(std::get<Command2>(result.value().command).get_argument<"params">()[0], "v"sv);
+}
+#endif
+TEST(glap_mapped, expand_response_file) {
+    auto path = write_arguments_file("glap_response_args", "--flag\r\n\n-c\nvalue\ninput"sv);
+    auto response = "@" + path.string();
+    {
+        auto args = glap::MappedArguments::expand(std::array{"glap"sv, std::string_view(response)});
+        ASSERT_TRUE(args) << args.error().message();
+        auto result = tests_parser(*args);
+        ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+        auto command = std::get<Command1>(result.value().command);
+        EXPECT_EQ(command.get_argument<"flag">().occurences, 1);
+        EXPECT_EQ(command.get_argument<"param">().value, "value"sv);
+        EXPECT_EQ(std::get<2>(command.arguments).value, "input"sv);
+    }
+    std::filesystem::remove(path);
+}
+TEST(glap_mapped, error_outlives_arguments) {
+    auto path = write_arguments_file("glap_error_args", "-f\n--pram"sv);
+    auto response = "@" + path.string();
+    auto result = [&] {
+        auto args = glap::MappedArguments::expand(std::array{"glap"sv, "command1"sv, std::string_view(response)});
+        EXPECT_TRUE(args) << args.error().message();
+        return tests_parser(*args);
+    }();
+    std::filesystem::remove(path);
+    ASSERT_FALSE(result) << "Parser successed when it should not";
+    EXPECT_NE(result.error().storage, nullptr);
+    EXPECT_EQ(result.error().error.parameter, "pram"sv);
+    EXPECT_EQ(result.error().error.suggestions()[0], "param"sv);
+}
+TEST(glap_mapped, empty_response_file) {
+    auto path = write_arguments_file("glap_empty_args", ""sv);
+    auto response = "@" + path.string();
+    {
+        auto args = glap::MappedArguments::expand(std::array{"glap"sv, std::string_view(response), "command1"sv});
+        ASSERT_TRUE(args) << args.error().message();
+        ASSERT_EQ(args->size(), 2);
+        EXPECT_EQ((*args)[1], "command1"sv);
+        EXPECT_TRUE(args->storage().empty());
+    }
+    std::filesystem::remove(path);
+}
+TEST(glap_mapped, missing_file) {
+    auto args = glap::MappedArguments::expand(std::array{"glap"sv, "@/nonexistent/glap_args"sv});
+    ASSERT_FALSE(args);
+    EXPECT_EQ(args.error(), std::errc::no_such_file_or_directory);
+}
+#pragma endregion
+
+#pragma region Glap environment tests
+using CommandEnv = glap::model::Command<glap::Names<"env">,
+    glap::model::Parameter<glap::Env<glap::Names<"port", 'p'>, "GLAP_TEST_PORT">, from_chars<int>>,
+    glap::model::Parameter<glap::Env<glap::Names<"host">, "GLAP_TEST_HOST">>,
+    glap::model::Parameters<glap::Env<glap::Names<"tags">, "GLAP_TEST_TAGS">>,
+    glap::model::Flag<glap::Env<glap::Names<"verbose", 'v'>, "GLAP_TEST_VERBOSE">>,
+    glap::model::Parameter<glap::Names<"other">>
+>;
+using ProgramEnv = glap::model::Program<"env", glap::model::DefaultCommand::FirstDefined, CommandEnv>;
+
+TEST(glap_environment, fills_unset_arguments) {
+    auto result = glap::parser<ProgramEnv>(std::array{"glap"sv, "--host=cli"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    auto envp = std::array<const char*, 6>{"PATH=/bin", "GLAP_TEST_PORT=8080", "GLAP_TEST_HOST=env", "GLAP_TEST_TAGS=a,b", "GLAP_TEST_VERBOSE=yes", nullptr};
+    auto applied = glap::apply_environment(result.value(), envp.data());
+    ASSERT_TRUE(applied) << applied.error().to_string();
+    auto& command = std::get<CommandEnv>(result.value().command);
+    EXPECT_EQ(command.get_argument<"port">().value, 8080);
+    EXPECT_EQ(command.get_argument<"host">().value, "cli"sv) << "command line value overriden";
+    ASSERT_EQ(command.get_argument<"tags">().size(), 1);
+    EXPECT_EQ(command.get_argument<"tags">()[0], "a,b"sv);
+    EXPECT_EQ(command.get_argument<"verbose">().occurences, 1);
+    EXPECT_FALSE(command.get_argument<"other">().value);
+}
+TEST(glap_environment, bad_values) {
+    auto check = [](const char* env) {
+        auto result = glap::parser<ProgramEnv>(std::array{"glap"sv});
+        ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+        auto envp = std::array<const char*, 2>{env, nullptr};
+        auto applied = glap::apply_environment(result.value(), envp.data());
+        ASSERT_FALSE(applied) << "bad value accepted: " << env;
+        EXPECT_EQ(applied.error().type, glap::Error::Type::Environment);
+    };
+    check("GLAP_TEST_PORT=http");
+    check("GLAP_TEST_VERBOSE=maybe");
+}
+TEST(glap_environment, process_environment) {
+    auto result = glap::parser<ProgramEnv>(std::array{"glap"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    ASSERT_TRUE(glap::apply_environment(result.value()));
+}
+#pragma endregion
+
+#pragma region Glap config tests
+TEST(glap_config, fills_unset_arguments) {
+    auto config = glap::ConfigFile::parse(
+        "# service defaults\n"
+        "port = 80\n"
+        "host=file\n"
+        "tags = 'a b'\n"
+        "tags = c\r\n"
+        "\n"
+        "[other]\n"
+        "unknown = 1\n"
+        "[env]\n"
+        "verbose\n"sv);
+    auto result = glap::parser<ProgramEnv>(std::array{"glap"sv, "--host=cli"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    auto envp = std::array<const char*, 2>{"GLAP_TEST_PORT=8080", nullptr};
+    ASSERT_TRUE(glap::apply_environment(result.value(), envp.data()));
+    auto applied = glap::apply_config(result.value(), config);
+    ASSERT_TRUE(applied) << applied.error().to_string();
+    auto& command = std::get<CommandEnv>(result.value().command);
+    EXPECT_EQ(command.get_argument<"port">().value, 8080) << "environment value overriden";
+    EXPECT_EQ(command.get_argument<"host">().value, "cli"sv) << "command line value overriden";
+    ASSERT_EQ(command.get_argument<"tags">().size(), 2);
+    EXPECT_EQ(command.get_argument<"tags">()[0], "a b"sv);
+    EXPECT_EQ(command.get_argument<"tags">()[1], "c"sv);
+    EXPECT_EQ(command.get_argument<"verbose">().occurences, 1);
+}
+TEST(glap_config, errors) {
+    auto check = [](std::string_view content, glap::Error::Code code, long line) {
+        auto config = glap::ConfigFile::parse(content);
+        auto result = glap::parser<ProgramEnv>(std::array{"glap"sv});
+        ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+        auto applied = glap::apply_config(result.value(), config);
+        ASSERT_FALSE(applied) << "bad config accepted: " << content;
+        EXPECT_EQ(applied.error().error.type, glap::Error::Type::Config);
+        EXPECT_EQ(applied.error().error.code, code);
+        EXPECT_EQ(applied.error().position, line);
+    };
+    check("host=a\nport=http"sv, glap::Error::Code::BadResolution, 2);
+    check("\n\nunknown=1"sv, glap::Error::Code::UnknownArgument, 3);
+    check("host\n"sv, glap::Error::Code::MissingValue, 1);
+    check("[env\nhost=a"sv, glap::Error::Code::SyntaxError, 1);
+    check(" = a"sv, glap::Error::Code::SyntaxError, 1);
+}
+TEST(glap_config, mapped_file) {
+    auto path = write_arguments_file("glap_config", "host=mapped\n");
+    auto result = glap::parser<ProgramEnv>(std::array{"glap"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    {
+        auto config = glap::ConfigFile::open(path);
+        ASSERT_TRUE(config) << config.error().message();
+        ASSERT_TRUE(glap::apply_config(result.value(), *config));
+    }
+    EXPECT_EQ(result.value().storage.size(), 1);
+    EXPECT_EQ(std::get<CommandEnv>(result.value().command).get_argument<"host">().value, "mapped"sv);
+}
+TEST(glap_config, mapped_file_partial_failure) {
+    auto path = write_arguments_file("glap_config_partial", "host=mapped\nport=http\n");
+    auto result = glap::parser<ProgramEnv>(std::array{"glap"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    {
+        auto config = glap::ConfigFile::open(path);
+        ASSERT_TRUE(config) << config.error().message();
+        auto applied = glap::apply_config(result.value(), *config);
+        ASSERT_FALSE(applied) << "bad port accepted";
+        EXPECT_EQ(applied.error().position, 2);
+    }
+    std::filesystem::remove(path);
+    EXPECT_EQ(result.value().storage.size(), 1) << "mapping dropped after a partial failure";
+    EXPECT_EQ(std::get<CommandEnv>(result.value().command).get_argument<"host">().value, "mapped"sv);
+}
+#pragma endregion
+
+#pragma region Glap parallel resolution tests
+using CommandParallel = glap::model::Command<glap::Names<"parallel">,
+    glap::model::Parameters<glap::Names<"ints", 'i'>, glap::discard, from_chars<int>>,
+    glap::model::Flag<glap::Names<"flag", 'f'>>,
+    glap::model::Inputs<glap::discard, from_chars<int>>
+>;
+static void check_parallel(const std::vector<std::string>& args) {
+    static auto pool = glap::ThreadPool(4);
+    auto views = std::vector<std::string_view>(args.begin(), args.end());
+    auto expected = glap::parser<CommandParallel>(views);
+    for (unsigned threads : {0u, 2u, 3u, 8u}) {
+        // 0 threads: on the pool
+        auto options = threads == 0 ? glap::ParseOptions{.pool = &pool} : glap::ParseOptions{.threads = threads};
+        auto result = glap::parser<CommandParallel>(views, options);
+        ASSERT_EQ(result.has_value(), expected.has_value()) << threads << " threads";
+        if (!expected) {
+            EXPECT_EQ(result.error().error.code, expected.error().error.code) << threads << " threads";
+            EXPECT_EQ(result.error().error.type, expected.error().error.type) << threads << " threads";
+            EXPECT_EQ(result.error().position, expected.error().position) << threads << " threads";
+            continue;
+        }
+        auto& ints = result.value().get_argument<"ints">();
+        auto& expected_ints = expected.value().get_argument<"ints">();
+        ASSERT_EQ(ints.size(), expected_ints.size());
+        for (size_t i = 0; i < ints.size(); ++i)
+            ASSERT_EQ(ints[i], expected_ints[i]);
+        auto& inputs = result.value().get_inputs();
+        auto& expected_inputs = expected.value().get_inputs();
+        ASSERT_EQ(inputs.size(), expected_inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i)
+            ASSERT_EQ(inputs[i], expected_inputs[i]);
+    }
+}
+TEST(glap_parallel, same_as_serial) {
+    auto args = std::vector<std::string>{};
+    for (int i = 0; i < 5000; ++i) {
+        args.push_back(std::to_string(i));
+        if (i % 7 == 0)
+            args.push_back("--ints=" + std::to_string(-i));
+        if (i % 11 == 0) {
+            args.push_back("-fi");
+            args.push_back(std::to_string(i * 2));
+        }
+    }
+    check_parallel(args);
+    auto bad_input = args;
+    bad_input[3000] = "x";
+    bad_input[4000] = "y";
+    check_parallel(bad_input);
+    auto bad_short = args;
+    bad_short.insert(bad_short.begin() + 2000, {"-i", "z"});
+    check_parallel(bad_short);
+    auto bad_syntax = bad_input;
+    bad_syntax.insert(bad_syntax.begin() + 2500, "---");
+    check_parallel(bad_syntax);
+    bad_syntax.insert(bad_syntax.begin() + 3500, "--unknown");
+    check_parallel(bad_syntax);
+}
+static std::atomic<int> failed_resolutions = 0;
+static glap::expected<int, glap::Discard> counted_from_chars(std::string_view v) {
+    auto result = from_chars<int>(v);
+    if (!result)
+        ++failed_resolutions;
+    return result;
+}
+TEST(glap_parallel, invalid_value_resolved_once) {
+    using CommandCounted = glap::model::Command<glap::Names<"counted">, glap::model::Inputs<glap::discard, counted_from_chars>>;
+    auto args = std::vector<std::string>{};
+    for (int i = 0; i < 1000; ++i)
+        args.push_back(i == 600 ? "x" : std::to_string(i));
+    auto views = std::vector<std::string_view>(args.begin(), args.end());
+    auto pool = glap::ThreadPool(3);
+    EXPECT_EQ(pool.size(), 3);
+    for (auto options : {glap::ParseOptions{.threads = 4}, glap::ParseOptions{.pool = &pool}}) {
+        failed_resolutions = 0;
+        auto result = glap::parser<CommandCounted>(views, options);
+        ASSERT_FALSE(result) << "Parser successed when it should not";
+        EXPECT_EQ(result.error().position, 600);
+        EXPECT_EQ(result.error().error.type, glap::Error::Type::Input);
+        EXPECT_EQ(failed_resolutions, 1);
+    }
+}
+TEST(glap_parallel, incremental_resolves_when_fed) {
+    using CommandCounted = glap::model::Command<glap::Names<"counted">, glap::model::Inputs<glap::discard, counted_from_chars>>;
+    using ProgramCounted = glap::model::Program<"glap", glap::model::DefaultCommand::FirstDefined, CommandCounted>;
+    auto pool = glap::ThreadPool(2);
+    failed_resolutions = 0;
+    auto parser = glap::IncrementalParser<ProgramCounted>(glap::ParseOptions{.threads = 4, .pool = &pool});
+    parser.feed(std::array{"glap"sv, "counted"sv, "1"sv, "x"sv});
+    EXPECT_EQ(failed_resolutions, 1) << "value not resolved when fed";
+    auto result = parser.finish();
+    ASSERT_FALSE(result) << "Parser successed when it should not";
+    EXPECT_EQ(result.error().position, 3);
+}
+TEST(glap_parallel, scratch_uses_resource) {
+    auto args = std::vector<std::string_view>{"1", "--ints=2", "3", "-i", "4", "5"};
+    CountingResource resource;
+    auto result = glap::parser<CommandParallel>(args, glap::ParseOptions{.resource = &resource, .threads = 4});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    EXPECT_EQ(result.value().get_argument<"ints">().size(), 2);
+    EXPECT_EQ(result.value().get_inputs().size(), 3);
+    // the two dynamic containers, the collected values, their slots and the resolved values of each argument
+    EXPECT_EQ(resource.allocations, 6);
+}
+#pragma endregion
+
+#pragma region Glap batch tests
+TEST(glap_batch, same_as_parser) {
+    auto lines = std::vector<std::vector<std::string>>{};
+    for (int i = 0; i < 1000; ++i) {
+        switch (i % 4) {
+        case 0: lines.push_back({"glap", "command1", "-f", "--param=" + std::to_string(i)}); break;
+        case 1: lines.push_back({"glap", "command3", "--int=" + std::to_string(i)}); break;
+        case 2: lines.push_back({"glap", "command3", "--int=nan"}); break;
+        case 3: lines.push_back({"glap", "unknown"}); break;
+        }
+    }
+    auto views = std::vector<std::vector<std::string_view>>{};
+    for (const auto& line : lines)
+        views.emplace_back(line.begin(), line.end());
+    auto check = [&](const std::vector<glap::PosExpected<ProgramTest>>& results) {
+        for (size_t i = 0; i < lines.size(); ++i) {
+            auto expected = tests_parser(views[i]);
+            ASSERT_EQ(results[i].has_value(), expected.has_value()) << "line " << i;
+            if (!expected) {
+                ASSERT_EQ(results[i].error().error.code, expected.error().error.code) << "line " << i;
+                ASSERT_EQ(results[i].error().position, expected.error().position) << "line " << i;
+            } else {
+                ASSERT_EQ(results[i].value().command.index(), expected.value().command.index()) << "line " << i;
+            }
+        }
+        ASSERT_EQ(std::get<Command1>(results[4].value().command).get_argument<"param">().value, "4"sv);
+        ASSERT_EQ(std::get<Command3>(results[5].value().command).get_argument<"int">().value, 5);
+    };
+    for (unsigned threads : {1u, 3u, 8u}) {
+        auto results = std::vector<glap::PosExpected<ProgramTest>>(lines.size());
+        ASSERT_TRUE(glap::parse_batch<ProgramTest>(views, std::span(results), glap::BatchOptions{.threads = threads, .chunk = 16}));
+        check(results);
+        ASSERT_FALSE(glap::parse_batch<ProgramTest>(views, std::span(results).first(lines.size() - 1))) << "output too small";
+        auto from_strings = std::vector<glap::PosExpected<ProgramTest>>(3);
+        glap::parse_batch<ProgramTest>(lines, from_strings, glap::BatchOptions{.threads = threads, .chunk = 7});
+        ASSERT_EQ(from_strings.size(), lines.size());
+        check(from_strings);
+    }
+}
+// arguments read as temporary strings would dangle in the results
+static_assert(!requires (std::vector<glap::PosExpected<ProgramTest>>& output) {
+    glap::parse_batch<ProgramTest>(std::vector<std::vector<int>>{} | std::views::transform([](const std::vector<int>& line) {
+        return line | std::views::transform([](int i) { return std::to_string(i); });
+    }), output);
+});
+static_assert(requires (std::vector<glap::PosExpected<ProgramTest>>& output) {
+    glap::parse_batch<ProgramTest>(std::vector<std::vector<std::string>>{}, output);
+});
+#pragma endregion
+
+#pragma region Glap help tests
+using CommandHelpTest = glap::help::model::Command<"command1", glap::help::model::Description<"first command">,
+    glap::help::model::Argument<"flag", glap::help::model::Description<"a flag">>
+>;
+using ProgramHelpTest = glap::help::model::Program<"test", glap::help::model::FullDescription<"test program", "tests glap">, CommandHelpTest>;
+using CommandUnicodeHelp = glap::help::model::Command<"unicode", glap::help::model::Description<"unicode names">>;
+
+static_assert(glap::help_text<CommandUnicodeHelp, CommandUnicode> == 
+    "unicode - unicode names\n\n"
+    "Usage:\n"
+    "    unicode [--verbose] [--quiet] [--name VALUE]\n\n"
+    "Arguments:\n\n"
+    "    é, verbose - (no description)\n"
+    "      q, quiet - (no description)\n"
+    "       🔥, name - (no description)");
+TEST(glap_help, program) {
+    constexpr auto text = glap::help_text<ProgramHelpTest, ProgramTestNoDefault>;
+    EXPECT_EQ(text,
+        "test_no_default - test program\n\ntests glap\n\n"
+        "Commands:\n\n"
+        "    t, command1 - first command\n"
+        "       command2 - (no description)\n"
+        "       command3 - (no description)"sv);
+    EXPECT_EQ((glap::get_help<ProgramHelpTest, ProgramTestNoDefault>()), text);
+}
+TEST(glap_help, command) {
+    constexpr auto text = glap::help_text<CommandHelpTest, Command1>;
+    EXPECT_EQ(text,
+        "command1 - first command\n\n"
+        "Usage:\n"
+        "    command1 [--flag] [--param VALUE] <INPUTS>\n\n"
+        "Arguments:\n\n"
+        "     f, flag - a flag\n"
+        "    c, param - (no description)\n"
+        "      INPUTS - (no description)"sv);
+    auto result = std::string();
+    glap::get_help<CommandHelpTest, Command1>(std::back_inserter(result));
+    EXPECT_EQ(result, text);
+}
+#pragma endregion
+
+#pragma region Glap completion tests
+static_assert(glap::completion_text<glap::completion::Fish, CommandHelpTest, Command1> ==
+    "complete -c command1 -f\n"
+    "complete -c command1 -s f -l flag -d 'a flag'\n"
+    "complete -c command1 -s c -l param -r\n"
+    "complete -c command1 -F\n");
+TEST(glap_completion, bash) {
+    constexpr auto text = glap::completion_text<glap::completion::Bash, ProgramHelpTest, ProgramTestNoDefault>;
+    EXPECT_TRUE(text.starts_with("_test_no_default() {\n"));
+    EXPECT_NE(text.find("compgen -W 'command1 command2 command3'"), std::string_view::npos);
+    EXPECT_NE(text.find("        command1|t)\n"), std::string_view::npos);
+    EXPECT_NE(text.find("            case $prev in\n                -a|-b|-c)\n"), std::string_view::npos);
+    EXPECT_NE(text.find("                --param=*|--params=*|--stack_args=*)\n"), std::string_view::npos);
+    EXPECT_NE(text.find("compgen -W '--flag -f --param= -a --params= -b --stack_args= -c'"), std::string_view::npos);
+    EXPECT_EQ(text.find("--params|"), std::string_view::npos) << "long parameter completed with a separate value";
+    EXPECT_EQ(text.find("|-*)"), std::string_view::npos);
+    EXPECT_TRUE(text.ends_with("complete -F _test_no_default test_no_default\n"));
+    EXPECT_EQ((glap::get_completion<glap::completion::Bash, ProgramHelpTest, ProgramTestNoDefault>()), text);
+}
+TEST(glap_completion, zsh) {
+    constexpr auto text = glap::completion_text<glap::completion::Zsh, ProgramHelpTest, ProgramTest>;
+    EXPECT_TRUE(text.starts_with("#compdef test\n"));
+    EXPECT_NE(text.find("        '*--flag[a flag]' \\\n"), std::string_view::npos);
+    EXPECT_NE(text.find("        '(--param -c)--param=-:value:_default' \\\n"), std::string_view::npos);
+    EXPECT_NE(text.find("        '(--param -c)-c:value:_default' \\\n"), std::string_view::npos);
+    EXPECT_EQ(text.find("--param:value"), std::string_view::npos) << "long parameter completed with a separate value";
+    EXPECT_NE(text.find("        'command1:first command'\n"), std::string_view::npos);
+    EXPECT_NE(text.find("        (-*)\n            _test_command1;;\n"), std::string_view::npos);
+    EXPECT_NE(text.find("    compdef _test test\n"), std::string_view::npos);
+}
+TEST(glap_completion, fish) {
+    constexpr auto text = glap::completion_text<glap::completion::Fish, void, ProgramTestNoDefault>;
+    EXPECT_NE(text.find("complete -c test_no_default -n __fish_use_subcommand -a command1\n"), std::string_view::npos);
+    EXPECT_NE(text.find("complete -c test_no_default -n '__fish_seen_subcommand_from command1 t' -s f -l flag\n"), std::string_view::npos);
+    EXPECT_NE(text.find("complete -c test_no_default -n '__fish_seen_subcommand_from command3' -l float -r\n"), std::string_view::npos);
+    EXPECT_EQ(text.find("-n __fish_use_subcommand -s"), std::string_view::npos);
+}
+#pragma endregion
+
+#pragma region Glap serialize tests
+static auto in_buffer(std::string_view view, std::string_view buffer) -> bool {
+    return view.data() >= buffer.data() && view.data() + view.size() <= buffer.data() + buffer.size();
+}
+TEST(glap_serialize, round_trip) {
+    auto result = tests_parser(std::array{"glap"sv, "command2"sv, "-ff"sv, "--param=hello"sv, "-b"sv, "x"sv, "--params=y"sv, "-c"sv, "s"sv, "in1"sv, "in2"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    auto bytes = glap::serialize(result.value());
+    auto snapshot = glap::deserialize<ProgramTest>(bytes);
+    ASSERT_TRUE(snapshot) << snapshot.error().to_string();
+    EXPECT_EQ(snapshot->program, "glap"sv);
+    EXPECT_TRUE(in_buffer(snapshot->program, bytes));
+    ASSERT_TRUE(std::holds_alternative<Command2>(snapshot->command));
+    auto& command = std::get<Command2>(snapshot->command);
+    EXPECT_EQ(command.get_argument<"flag">().occurences, 2);
+    EXPECT_EQ(command.get_argument<"param">().value, "hello"sv);
+    EXPECT_TRUE(in_buffer(*command.get_argument<"param">().value, bytes));
+    ASSERT_EQ(command.get_argument<"params">().size(), 2);
+    EXPECT_EQ(command.get_argument<"params">()[1], "y"sv);
+    ASSERT_EQ(command.get_argument<"stack_args">().size(), 1);
+    EXPECT_EQ(command.get_argument<"stack_args">()[0], "s"sv);
+    ASSERT_EQ(command.get_inputs().size(), 2);
+    EXPECT_EQ(command.get_inputs()[0], "in1"sv);
+    EXPECT_EQ(glap::serialize(*snapshot), bytes);
+}
+TEST(glap_serialize, arithmetic_lists) {
+    auto result = glap::parser<CommandNumbers>(std::array{"-i"sv, "7"sv, "--ints=-8"sv, "-s"sv, "9"sv, "2.5"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    auto bytes = glap::serialize(result.value());
+    auto snapshot = glap::deserialize<CommandNumbers>(bytes);
+    ASSERT_TRUE(snapshot) << snapshot.error().to_string();
+    EXPECT_TRUE(std::ranges::equal(snapshot->get_argument<"ints">().span(), std::array{7, -8}));
+    EXPECT_TRUE(std::ranges::equal(snapshot->get_argument<"stack_ints">().span(), std::array{9}));
+    EXPECT_TRUE(std::ranges::equal(snapshot->get_inputs().span(), std::array{2.5}));
+    EXPECT_FALSE(glap::deserialize<CommandNumbers>(std::string_view(bytes).substr(0, bytes.size() - 1)));
+}
+TEST(glap_serialize, trivially_copyable_values) {
+    auto result = tests_parser(std::array{"glap"sv, "command3"sv, "--int=-42"sv, "--point=3,4"sv, "a"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    auto bytes = glap::serialize(result.value());
+    auto snapshot = glap::deserialize<ProgramTest>(bytes);
+    ASSERT_TRUE(snapshot) << snapshot.error().to_string();
+    auto& command = std::get<Command3>(snapshot->command);
+    EXPECT_FALSE(command.get_argument<"float">().value);
+    EXPECT_EQ(command.get_argument<"int">().value, -42);
+    EXPECT_EQ(command.get_argument<"point">().value, (Point{3, 4}));
+    ASSERT_EQ(command.get_inputs().size(), 1);
+    EXPECT_EQ(command.get_inputs()[0], "a"sv);
+}
+TEST(glap_serialize, lazy_and_command_models) {
+    lazy_resolutions = 0;
+    auto lazy = glap::parser<ProgramLazy>(std::array{"glap"sv, "--int=12"sv, "3"sv});
+    ASSERT_TRUE(lazy) << "Parser failed: " << lazy.error().to_string();
+    auto lazy_bytes = glap::serialize(lazy.value());
+    auto lazy_snapshot = glap::deserialize<ProgramLazy>(lazy_bytes);
+    ASSERT_TRUE(lazy_snapshot) << lazy_snapshot.error().to_string();
+    auto& param = std::get<CommandLazy>(lazy_snapshot->command).get_argument<"int">().value;
+    ASSERT_TRUE(param);
+    EXPECT_FALSE(param->resolved());
+    EXPECT_EQ(param->get(), 12);
+    EXPECT_EQ(lazy_resolutions, 1);
+
+    auto inputs = tests_no_command(std::array{"a"sv, "b"sv});
+    ASSERT_TRUE(inputs) << "Parser failed: " << inputs.error().to_string();
+    CountingResource resource;
+    auto bytes = glap::serialize(inputs.value());
+    auto snapshot = glap::deserialize<ProgramTestNoCommand>(bytes, &resource);
+    ASSERT_TRUE(snapshot) << snapshot.error().to_string();
+    ASSERT_EQ(snapshot->get_inputs().size(), 2);
+    EXPECT_EQ(snapshot->get_inputs()[1], "b"sv);
+    EXPECT_EQ(resource.allocations, 1);
+}
+TEST(glap_serialize, errors) {
+    auto result = tests_parser(std::array{"glap"sv, "command2"sv, "-f"sv, "--params=y"sv, "in"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    auto bytes = glap::serialize(result.value());
+    for (size_t size = 0; size < bytes.size(); ++size) {
+        auto snapshot = glap::deserialize<ProgramTest>(std::string_view(bytes).substr(0, size));
+        ASSERT_FALSE(snapshot) << "truncated snapshot accepted: " << size;
+        EXPECT_EQ(snapshot.error().type, glap::Error::Type::Snapshot);
+        EXPECT_EQ(snapshot.error().code, glap::Error::Code::SyntaxError);
+    }
+    EXPECT_FALSE(glap::deserialize<ProgramTest>(bytes + "x"));
+    auto foreign = glap::deserialize<ProgramTestNoDefault>(bytes);
+    ASSERT_FALSE(foreign) << "snapshot of another model accepted";
+    EXPECT_EQ(foreign.error().code, glap::Error::Code::SyntaxError);
+
+    auto bad_index = bytes;
+    auto index_pos = 12 + 4 + "glap"sv.size();
+    bad_index[index_pos] = 5;
+    auto bad_command = glap::deserialize<ProgramTest>(bad_index);
+    ASSERT_FALSE(bad_command);
+    EXPECT_EQ(bad_command.error().code, glap::Error::Code::BadCommand);
+}
+TEST(glap_serialize, corrupted_count) {
+    auto set_count = [](std::string bytes, size_t pos, std::uint32_t count) {
+        std::memcpy(bytes.data() + pos, &count, sizeof(count));
+        return bytes;
+    };
+    auto result = tests_parser(std::array{"glap"sv, "command2"sv, "-f"sv, "--params=y"sv, "in"sv});
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    // header, program name, command index, presence bits and flag occurences come before the list count
+    auto count_pos = 12 + 4 + "glap"sv.size() + 4 + 1 + 8;
+    auto bytes = glap::serialize(result.value());
+    ASSERT_TRUE(glap::deserialize<ProgramTest>(set_count(bytes, count_pos, 1)));
+    for (auto count : {0xFFFFFFF0u, 1u << 20, 3u}) {
+        auto snapshot = glap::deserialize<ProgramTest>(set_count(bytes, count_pos, count));
+        ASSERT_FALSE(snapshot) << "corrupted count accepted: " << count;
+        EXPECT_EQ(snapshot.error().code, glap::Error::Code::SyntaxError);
+        EXPECT_EQ(snapshot.error().parameter, "params"sv);
+    }
+
+    auto numbers = glap::parser<CommandNumbers>(std::array{"-i"sv, "7"sv});
+    ASSERT_TRUE(numbers) << "Parser failed: " << numbers.error().to_string();
+    auto number_bytes = glap::serialize(numbers.value());
+    auto snapshot = glap::deserialize<CommandNumbers>(set_count(number_bytes, 12 + 1, 0xFFFFFFF0u));
+    ASSERT_FALSE(snapshot) << "corrupted count accepted";
+    EXPECT_EQ(snapshot.error().code, glap::Error::Code::SyntaxError);
+}
+#pragma endregion
+
+#pragma region Glap detach tests
+TEST(glap_detach, program_owns_values) {
+    auto args = std::vector<std::string>{"glap", "command2", "--param=hello", "-b", "x", "--params=y", "in1", "in2"};
+    auto result = tests_parser(std::vector<std::string_view>(args.begin(), args.end()));
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    glap::detach(result.value());
+    ASSERT_EQ(result.value().storage.size(), 1) << "one allocation expected";
+    for (auto& arg : args)
+        std::fill(arg.begin(), arg.end(), '#');
+    EXPECT_EQ(result.value().program, "glap"sv);
+    const auto& command = std::get<Command2>(result.value().command);
+    EXPECT_EQ(command.get_argument<"param">().value, "hello"sv);
+    ASSERT_EQ(command.get_argument<"params">().size(), 2);
+    EXPECT_EQ(command.get_argument<"params">()[0], "x"sv);
+    EXPECT_EQ(command.get_argument<"params">()[1], "y"sv);
+    ASSERT_EQ(command.get_inputs().size(), 2);
+    EXPECT_EQ(command.get_inputs()[1], "in2"sv);
+}
+TEST(glap_detach, lazy_and_command_models) {
+    auto args = std::vector<std::string>{"glap", "--int=12", "3"};
+    auto result = glap::parser<ProgramLazy>(std::vector<std::string_view>(args.begin(), args.end()));
+    ASSERT_TRUE(result) << "Parser failed: " << result.error().to_string();
+    glap::detach(result.value());
+    std::fill(args[1].begin(), args[1].end(), '#');
+    auto& command = std::get<CommandLazy>(result.value().command);
+    EXPECT_EQ(command.get_argument<"int">().value->raw(), "12"sv);
+    EXPECT_EQ(command.get_argument<"int">().value->get(), 12);
+
+    auto inputs = std::vector<std::string>{"a", "bc"};
+    auto no_command = tests_no_command(std::vector<std::string_view>(inputs.begin(), inputs.end()));
+    ASSERT_TRUE(no_command) << "Parser failed: " << no_command.error().to_string();
+    auto storage = glap::detach(no_command.value());
+    ASSERT_TRUE(storage);
+    inputs.clear();
+    EXPECT_EQ(no_command.value().get_inputs()[1], "bc"sv);
+    auto empty = tests_no_command(std::array<std::string_view, 0>{});
+    ASSERT_TRUE(empty) << "Parser failed: " << empty.error().to_string();
+    EXPECT_FALSE(glap::detach(empty.value())) << "allocation without values";
+}
+#pragma endregion
+
+#pragma region Glap utf8 tests
+static_assert(glap::utils::uni::utf8_length("h\u00e9llo \U0001F525").value() == 7);
+static_assert(glap::utils::uni::codepoint("\U0001F525").value() == U'\U0001F525');
+static_assert(!glap::utils::uni::codepoint("\xC0\xAF"));
+static_assert(glap::utils::uni::utf8_count("h\u00e9llo w\u00f6rld \U0001F525") == 13);
+TEST(glap_utf8, length) {
+    auto ascii = std::string(100, 'a');
+    EXPECT_EQ(glap::utils::uni::utf8_length("a\u00e9\u4e2d\U0001F525"sv).value(), 4u);
+    EXPECT_EQ(glap::utils::uni::utf8_length(std::string_view(ascii).substr(0, 40)).value(), 40u);
+    EXPECT_EQ(glap::utils::uni::utf8_length(""sv).value(), 0u);
+}
+TEST(glap_utf8, long_length) {
+    auto ascii = std::string(300, 'a');
+    EXPECT_EQ(glap::utils::uni::utf8_length(ascii).value(), 300u);
+    auto mixed = std::string();
+    for (int i = 0; i < 1000; ++i)
+        mixed += "a\u00e9\u4e2d\U0001F525";
+    EXPECT_EQ(glap::utils::uni::utf8_length(mixed).value(), 4000u);
+    EXPECT_EQ(glap::utils::uni::utf8_count(std::string_view(mixed).substr(1)), 3999u);
+}
+TEST(glap_utf8, invalid_position) {
+    auto check = [](std::string_view str, size_t pos) {
+        auto result = glap::utils::uni::utf8_length(str);
+        ASSERT_FALSE(result) << "invalid string accepted: " << str;
+        EXPECT_EQ(result.error().pos, pos) << "wrong position for: " << str;
+    };
+    auto ascii = std::string(40, 'a');
+    check("\x80", 0);                          // lone continuation byte
+    check("ab\xC3(", 2);                       // bad continuation byte
+    check("ab\xE2\x82", 2);                    // truncated sequence
+    check("\xC0\xAF", 0);                      // overlong encoding
+    check("a\xED\xA0\x80", 1);                 // surrogate
+    check("\xF4\x90\x80\x80", 0);              // above U+10FFFF
+    check(ascii + "\xFF" + ascii, 40);         // after a SIMD block
+    check(ascii + "\u00e9" + ascii + "\xC3", 82);
+}
+TEST(glap_utf8, codepoint) {
+    EXPECT_EQ(glap::utils::uni::codepoint("a"sv), U'a');
+    EXPECT_EQ(glap::utils::uni::codepoint("\u00e9"sv), U'\u00e9');
+    EXPECT_EQ(glap::utils::uni::codepoint("\u4e2d"sv), U'\u4e2d');
+    EXPECT_FALSE(glap::utils::uni::codepoint("\xE4\xB8"sv)) << "truncated sequence accepted";
+    EXPECT_FALSE(glap::utils::uni::codepoint("\xE4(\xAD"sv)) << "bad continuation byte accepted";
+    EXPECT_FALSE(glap::utils::uni::codepoint(""sv)) << "empty string accepted";
+}
 #pragma endregion
\ No newline at end of file
@@ -4,11 +4,20 @@ add_rules("mode.debug", "mode.release", "mode.asan")
 add_requires("fmt 9.0.0", {optional = true}) -- required only if stl has not std::format
 add_requires("tl_expected", {optional = true}) -- required only if stl has not std::expected
 add_requires("gtest 1.12", {optional = true}) -- required only for glap-tests
+add_requires("benchmark", {optional = true}) -- required only for glap-bench
 
 option("build_tests")
     set_default(false)
     set_showmenu(true)
     set_description("Build tests")
+option("build_bench")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Build benchmarks")
+option("compile_bench_sizes")
+    set_default("10x10,50x20,100x50,200x100")
+    set_showmenu(true)
+    set_description("Models compiled by glap-compile-bench, as COMMANDSxARGUMENTS separated by commas")
 option("use_tl_expected")
     set_showmenu(true)
     set_description("Use tl::expected instead of std::expected")
@@ -52,7 +61,12 @@ target("glap")
     else
         set_languages("cxx20")
     end
-    add_files("src/*.cpp")
+    if has_config("enable_module") then
+        -- sources are implementation units of the module, attached to it instead of to the global module
+        add_files("src/*.cpp", {defines = "GLAP_MODULE"})
+    else
+        add_files("src/*.cpp")
+    end
     add_headerfiles("include/(glap/**.h)", "include/(glap/**.inl)")
     add_includedirs("include", {public = true})
     add_options("use_tl_expected", "use_fmt", "enable_std_module")
@@ -156,4 +170,42 @@ if has_config("build_tests") then
                 -- nothing to install
             end)
     end
+end
+
+if has_config("build_bench") then
+    target("glap-bench")
+        set_kind("binary")
+        if not has_config("use_tl_expected") then
+            set_languages("cxxlatest")
+        else
+            set_languages("cxx20")
+        end
+        add_deps("glap")
+        add_packages("benchmark")
+        add_files("bench/*.cpp")
+        add_options("use_tl_expected", "use_fmt")
+        if is_plat("linux", "macosx") then
+            add_syslinks("pthread")
+        end
+        on_install(function (target)
+            -- nothing to install
+        end)
+
+    target("glap-compile-bench")
+        set_kind("object")
+        if not has_config("use_tl_expected") then
+            set_languages("cxxlatest")
+        else
+            set_languages("cxx20")
+        end
+        set_default(false)
+        add_deps("glap")
+        add_options("use_tl_expected", "use_fmt")
+        on_build(function (target)
+            import("bench.compile_bench")
+            compile_bench(target, get_config("compile_bench_sizes"))
+        end)
+        on_install(function (target)
+            -- nothing to install
+        end)
 end
\ No newline at end of file